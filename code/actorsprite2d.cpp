@@ -14,6 +14,7 @@
 #include <utilities/settings.h>
 #include <common/actordata.h>
 #include <common/size.h>
+#include <common/viewcull.h>
 #include <2d/sprite2d.h>
 #include <2d/iaibase2d.h>
 #include <objectdata/objectdatamanager.h>
@@ -212,17 +213,11 @@ CSprite2D & CActorSprite2D::GetSprite( const std::string & name )
 
 
 /************************************************************************
-*    desc:  Render the actor
+*    desc:  Is the actor in view
 ************************************************************************/
 bool CActorSprite2D::InView()
 {
-    if( m_projectionType == NDefs::EPT_ORTHOGRAPHIC )
-        return InOrthographicView();
-
-    else if( m_projectionType == NDefs::EPT_PERSPECTIVE )
-        return InPerspectiveView();
-
-    return true;
+    return CViewCull::Instance().InView( m_projectionType, m_transPos, m_pos.z, m_scaledRadius );
 
 }   // InView
 
@@ -232,16 +227,7 @@ bool CActorSprite2D::InView()
  ************************************************************************/
 bool CActorSprite2D::InOrthographicView()
 {
-    // Check against the right side of the screen
-    if( std::fabs(m_transPos.x) > (CSettings::Instance().GetDefaultSizeHalf().w + m_scaledRadius) )
-        return false;
-
-    // Check against the top of the screen
-    if( std::fabs(m_transPos.y) > (CSettings::Instance().GetDefaultSizeHalf().h + m_scaledRadius) )
-        return false;
-
-    // If we made it this far, the object is in view
-    return true;
+    return CViewCull::Instance().InOrthographicView( m_transPos, m_scaledRadius );
 
 }   // InOrthographicView
 
@@ -251,18 +237,7 @@ bool CActorSprite2D::InOrthographicView()
  ************************************************************************/
 bool CActorSprite2D::InPerspectiveView()
 {
-    const CSize<float> & aspectRatio = CSettings::Instance().GetScreenAspectRatio();
-
-    // Check the right and left sides of the screen
-    if( std::fabs(m_transPos.x) > ((std::fabs(m_pos.z) * aspectRatio.w) + m_scaledRadius) )
-        return false;
-
-    // Check the top and bottom sides of the screen
-    if( std::fabs(m_transPos.y) > ((std::fabs(m_pos.z) * aspectRatio.h) + m_scaledRadius) )
-        return false;
-
-    // if we made it this far, the object was not culled
-    return true;
+    return CViewCull::Instance().InPerspectiveView( m_transPos, m_pos.z, m_scaledRadius );
 
 }   // InPerspectiveView
 
@@ -0,0 +1,231 @@
+/************************************************************************
+*    FILE NAME:       affine2d.h
+*
+*    DESCRIPTION:     Compact 2D affine matrix class. Same row vector
+*                     convention as CMatrix but only the 3x2 part that
+*                     2D transforms use.
+*
+*                     | a  b  0  0 |
+*                     | c  d  0  0 |
+*                     | 0  0  1  0 |
+*                     | tx ty z  1 |
+************************************************************************/
+
+#ifndef __affine_2d_h__
+#define __affine_2d_h__
+
+// Game lib dependencies
+#include <common/point.h>
+#include <common/matrix.h>
+#include <common/fastmath.h>
+
+class CAffine2D
+{
+public:
+
+    // 2x2 rotation/scale part
+    float a, b, c, d;
+
+    // Translation
+    float tx, ty;
+
+    // Depth. Not touched by the 2D math, just carried through to the 4x4
+    float z;
+
+    /************************************************************************
+    *    desc:  Constructor
+    ************************************************************************/
+    CAffine2D() : a(1), b(0), c(0), d(1), tx(0), ty(0), z(0)
+    {
+    }   // Constructor
+
+    /************************************************************************
+    *    desc:  Constructor - Pull the 2D part out of a 4x4 matrix
+    ************************************************************************/
+    explicit CAffine2D( const CMatrix & obj )
+    {
+        const float * pMat = obj();
+
+        a = pMat[0];   b = pMat[1];
+        c = pMat[4];   d = pMat[5];
+        tx = pMat[12]; ty = pMat[13];
+        z = pMat[14];
+
+    }   // Constructor
+
+    /************************************************************************
+    *    desc:  Reset to the identity
+    ************************************************************************/
+    void Identity()
+    {
+        a = 1; b = 0;
+        c = 0; d = 1;
+        tx = 0; ty = 0;
+        z = 0;
+
+    }   // Identity
+
+    /************************************************************************
+    *    desc:  Build the scale, rotate and translate in one pass. Same
+    *           result as the 2D CMatrix::SetTRS
+    *
+    *    param: const CPoint<float> & pos - translation
+    *           float radianZ - rotation around the z axis
+    *           const CPoint<float> & scale - scale
+    ************************************************************************/
+    void SetTRS( const CPoint<float> & pos, float radianZ, const CPoint<float> & scale )
+    {
+        float sinZ, cosZ;
+        NFastMath::SinCos( radianZ, sinZ, cosZ );
+
+        a = scale.x * cosZ;
+        b = scale.x * sinZ;
+        c = scale.y * -sinZ;
+        d = scale.y * cosZ;
+        tx = pos.x;
+        ty = pos.y;
+        z = pos.z;
+
+    }   // SetTRS
+
+    /************************************************************************
+    *    desc:  Scale the result of this transform. Same as merging with a
+    *           scale matrix.
+    ************************************************************************/
+    void Scale( const CPoint<float> & scale )
+    {
+        a *= scale.x;  b *= scale.y;
+        c *= scale.x;  d *= scale.y;
+        tx *= scale.x; ty *= scale.y;
+
+    }   // Scale
+
+    void Scale( float scale )
+    {
+        Scale( CPoint<float>( scale, scale ) );
+
+    }   // Scale
+
+    /************************************************************************
+    *    desc:  Scale before this transform. Same as merging this into a
+    *           scale matrix. Used for the quad vertex scale.
+    ************************************************************************/
+    void PreScale( const CPoint<float> & scale )
+    {
+        a *= scale.x; b *= scale.x;
+        c *= scale.y; d *= scale.y;
+
+    }   // PreScale
+
+    /************************************************************************
+    *    desc:  Translate the result of this transform
+    ************************************************************************/
+    void Translate( const CPoint<float> & point )
+    {
+        tx += point.x;
+        ty += point.y;
+        z += point.z;
+
+    }   // Translate
+
+    /************************************************************************
+    *    desc:  The multiplication operator. 12 multiplies instead of the
+    *           64 of a 4x4 merge.
+    *
+    *    param:  CAffine2D & obj - matrix to multiply
+    *
+    *    return: CAffine2D - multiplied matrix
+    ************************************************************************/
+    CAffine2D operator * ( const CAffine2D & obj ) const
+    {
+        CAffine2D tmp;
+
+        tmp.a = (a * obj.a) + (b * obj.c);
+        tmp.b = (a * obj.b) + (b * obj.d);
+        tmp.c = (c * obj.a) + (d * obj.c);
+        tmp.d = (c * obj.b) + (d * obj.d);
+        tmp.tx = (tx * obj.a) + (ty * obj.c) + obj.tx;
+        tmp.ty = (tx * obj.b) + (ty * obj.d) + obj.ty;
+        tmp.z = z + obj.z;
+
+        return tmp;
+
+    }   // operator *
+
+    /************************************************************************
+    *    desc:  The multiplication operator
+    *
+    *    param:  CAffine2D & obj - matrix to multiply
+    *
+    *    return: CAffine2D & - multiplied matrix
+    ************************************************************************/
+    CAffine2D & operator *= ( const CAffine2D & obj )
+    {
+        *this = *this * obj;
+
+        return *this;
+
+    }   // operator *=
+
+    /************************************************************************
+    *    desc:  Transform a point. Z is passed through
+    ************************************************************************/
+    void Transform( CPoint<float> & dest, const CPoint<float> & source ) const
+    {
+        const float x = source.x;
+        const float y = source.y;
+
+        dest.x = (x * a) + (y * c) + tx;
+        dest.y = (x * b) + (y * d) + ty;
+        dest.z = source.z;
+
+    }   // Transform
+
+    /************************************************************************
+    *    desc:  Transform an array of points. Dest can be the same as source
+    ************************************************************************/
+    void TransformBatch( CPoint<float> * pDest, const CPoint<float> * pSource, int count ) const
+    {
+        for( int i = 0; i < count; ++i )
+            Transform( pDest[i], pSource[i] );
+
+    }   // TransformBatch
+
+    /************************************************************************
+    *    desc:  Expand to a 4x4 matrix
+    *
+    *    param:  float dest[16] - destination matrix array
+    ************************************************************************/
+    void ToMatrix( float dest[16] ) const
+    {
+        dest[0]  = a;  dest[1]  = b;  dest[2]  = 0; dest[3]  = 0;
+        dest[4]  = c;  dest[5]  = d;  dest[6]  = 0; dest[7]  = 0;
+        dest[8]  = 0;  dest[9]  = 0;  dest[10] = 1; dest[11] = 0;
+        dest[12] = tx; dest[13] = ty; dest[14] = z; dest[15] = 1;
+
+    }   // ToMatrix
+
+    /************************************************************************
+    *    desc:  Expand to a 4x4 matrix and merge with another (normally the
+    *           view projection) for uploading to the shader. The zero
+    *           and one entries are skipped so it's half of a 4x4 merge.
+    *
+    *    param:  float dest[16] - destination matrix array
+    *            const CMatrix & obj - matrix to merge with
+    ************************************************************************/
+    void MergeToMatrix( float dest[16], const CMatrix & obj ) const
+    {
+        const float * pMat = obj();
+
+        for( int j = 0; j < 4; ++j )
+        {
+            dest[j]    = (a * pMat[j]) + (b * pMat[4+j]);
+            dest[4+j]  = (c * pMat[j]) + (d * pMat[4+j]);
+            dest[8+j]  = pMat[8+j];
+            dest[12+j] = (tx * pMat[j]) + (ty * pMat[4+j]) + (z * pMat[8+j]) + pMat[12+j];
+        }
+
+    }   // MergeToMatrix
+};
+
+#endif  // __affine_2d_h__
@@ -0,0 +1,374 @@
+/************************************************************************
+*    FILE NAME:       benchmath.cpp
+*
+*    DESCRIPTION:     Headless math microbenchmarks (bench_math target).
+*                     Times the CMatrix, CQuaternion and kernel paths
+*                     over a range of batch sizes and writes the results
+*                     to stdout as JSON so runs can be diffed.
+*
+*                     Build: benchmath.cpp + the common math sources
+*                     (matrix.cpp, matrixsimd.cpp, quaternionsimd.cpp,
+*                     fastmath.cpp) at -O2
+*
+*                     Usage: bench_math [--filter=name] [--ops=count]
+************************************************************************/
+
+// Game lib dependencies
+#include <common/matrix.h>
+#include <common/matrixsimd.h>
+#include <common/quaternion.h>
+#include <common/quaternionsimd.h>
+#include <common/fastmath.h>
+#include <common/point.h>
+#include <common/radian.h>
+
+// Standard lib dependencies
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // One timed run
+    class CBenchResult
+    {
+    public:
+        std::string name;
+        std::string variant;
+        int batch;
+        double nsPerOp;
+        double opsPerSec;
+    };
+
+    std::vector<CBenchResult> resultVec;
+
+    // Only run benchmarks that contain this string
+    std::string filterStr;
+
+    // Minimum number of operations per timed run
+    int minOpsPerRun = 2000000;
+
+    // Batch sizes to time. Small batches stay in L1, large ones don't.
+    const int BATCH_SIZES[] = { 16, 256, 4096, 65536 };
+
+    // Results are added here so the optimizer can't drop the work
+    volatile float sink = 0.0f;
+
+    /************************************************************************
+    *    desc:  Random float in a range
+    ************************************************************************/
+    float RandRange( float low, float high )
+    {
+        return low + ((high - low) * (float(std::rand()) / float(RAND_MAX)));
+
+    }   // RandRange
+
+    /************************************************************************
+    *    desc:  Time the function. func( batch ) does batch operations.
+    ************************************************************************/
+    template <typename Func>
+    void Run( const char * name, const char * variant, int batch, Func func )
+    {
+        if( !filterStr.empty() && (std::string(name).find( filterStr ) == std::string::npos) )
+            return;
+
+        const int reps = (minOpsPerRun / batch) > 0 ? (minOpsPerRun / batch) : 1;
+
+        // Warm up the caches and the branch predictors
+        func( batch );
+
+        auto start = std::chrono::steady_clock::now();
+
+        for( int i = 0; i < reps; ++i )
+            func( batch );
+
+        auto end = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        const double ops = double(batch) * reps;
+
+        CBenchResult result;
+        result.name = name;
+        result.variant = variant;
+        result.batch = batch;
+        result.nsPerOp = ns / ops;
+        result.opsPerSec = (ns > 0.0) ? (ops * 1e9 / ns) : 0.0;
+
+        resultVec.push_back( result );
+
+        std::fprintf( stderr, "%-16s %-24s %6d %10.2f ns/op\n", name, variant, batch, result.nsPerOp );
+
+    }   // Run
+
+    /************************************************************************
+    *    desc:  Matrix with a random rotation, scale and translation
+    ************************************************************************/
+    CMatrix RandomMatrix()
+    {
+        CMatrix matrix;
+        matrix.SetTRS(
+            CPoint( RandRange( -100, 100 ), RandRange( -100, 100 ), RandRange( -100, 100 ) ),
+            CRadian( RandRange( -3, 3 ), RandRange( -3, 3 ), RandRange( -3, 3 ) ),
+            CPoint( RandRange( 0.5f, 2 ), RandRange( 0.5f, 2 ), RandRange( 0.5f, 2 ) ) );
+
+        return matrix;
+
+    }   // RandomMatrix
+
+    /************************************************************************
+    *    desc:  Check a multiply kernel against the scalar kernel including
+    *           the aliased case used by MergeMatrix
+    ************************************************************************/
+    bool VerifyMultiply( NMatrixSimd::MultiplyFunc pFunc, const CMatrix & a, const CMatrix & b )
+    {
+        float expected[16], result[16], alias[16];
+
+        NMatrixSimd::MultiplyScalar( expected, a(), b() );
+        pFunc( result, a(), b() );
+
+        std::memcpy( alias, a(), sizeof(alias) );
+        pFunc( alias, alias, b() );
+
+        for( int i = 0; i < 16; ++i )
+            if( (std::fabs( expected[i] - result[i] ) > 1e-3f) || (std::fabs( expected[i] - alias[i] ) > 1e-3f) )
+                return false;
+
+        return true;
+
+    }   // VerifyMultiply
+
+    /************************************************************************
+    *    desc:  Write the results as JSON
+    ************************************************************************/
+    void WriteJson( const char * selectedKernel )
+    {
+        std::printf( "{\n" );
+        std::printf( "  \"selected_kernel\": \"%s\",\n", selectedKernel );
+        std::printf( "  \"min_ops_per_run\": %d,\n", minOpsPerRun );
+        std::printf( "  \"results\": [\n" );
+
+        for( size_t i = 0; i < resultVec.size(); ++i )
+        {
+            const CBenchResult & result = resultVec[i];
+
+            std::printf( "    { \"name\": \"%s\", \"variant\": \"%s\", \"batch\": %d, \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f }%s\n",
+                result.name.c_str(), result.variant.c_str(), result.batch,
+                result.nsPerOp, result.opsPerSec, (i + 1 < resultVec.size()) ? "," : "" );
+        }
+
+        std::printf( "  ]\n" );
+        std::printf( "}\n" );
+
+    }   // WriteJson
+}
+
+
+/************************************************************************
+*    desc:  Entry point
+************************************************************************/
+int main( int argc, char * argv[] )
+{
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strncmp( argv[i], "--filter=", 9 ) == 0 )
+            filterStr = argv[i] + 9;
+
+        else if( std::strncmp( argv[i], "--ops=", 6 ) == 0 )
+            minOpsPerRun = std::atoi( argv[i] + 6 );
+
+        else
+        {
+            std::fprintf( stderr, "usage: bench_math [--filter=name] [--ops=count]\n" );
+            return 1;
+        }
+    }
+
+    if( minOpsPerRun < 1 )
+        minOpsPerRun = 1;
+
+    const NMatrixSimd::EKernel selectedKernel = NMatrixSimd::SelectKernel();
+    const NMatrixSimd::EKernel kernelAry[] = { NMatrixSimd::EK_SCALAR, NMatrixSimd::EK_SSE2, NMatrixSimd::EK_AVX2 };
+
+    // Test data sized for the largest batch
+    const int maxBatch = BATCH_SIZES[(sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0])) - 1];
+
+    std::vector<CMatrix> aVec( maxBatch ), bVec( maxBatch ), destVec( maxBatch );
+    std::vector<CPoint> srcPointVec( maxBatch ), destPointVec( maxBatch ), targetVec( maxBatch );
+    std::vector<CRadian> radianVec( maxBatch );
+    std::vector<CQuaternion> quatVec( maxBatch );
+    std::vector<float> quatX( maxBatch ), quatY( maxBatch ), quatZ( maxBatch ), quatW( maxBatch );
+    std::vector<float> matrixAry( maxBatch * 16 );
+
+    for( int i = 0; i < maxBatch; ++i )
+    {
+        aVec[i] = RandomMatrix();
+        bVec[i] = RandomMatrix();
+        srcPointVec[i] = CPoint( RandRange( -100, 100 ), RandRange( -100, 100 ), RandRange( -100, 100 ) );
+        targetVec[i] = CPoint( RandRange( -100, 100 ), RandRange( -100, 100 ), RandRange( 10, 100 ) );
+        radianVec[i] = CRadian( RandRange( -3, 3 ), RandRange( -3, 3 ), RandRange( -3, 3 ) );
+
+        quatVec[i].Set( RandRange( -1, 1 ), RandRange( -1, 1 ), RandRange( -1, 1 ), RandRange( -1, 1 ) );
+        quatX[i] = quatVec[i].x;
+        quatY[i] = quatVec[i].y;
+        quatZ[i] = quatVec[i].z;
+        quatW[i] = quatVec[i].w;
+    }
+
+    const CQuatSoA quatSoA( &quatX[0], &quatY[0], &quatZ[0], &quatW[0] );
+    const CPoint cameraPos( 0, 0, -20 );
+    const CPoint cameraUp( 0, 1, 0 );
+    const CPoint unitScale( 1, 1, 1 );
+
+    for( auto batch : BATCH_SIZES )
+    {
+        // Kernel dependent benchmarks
+        for( auto kernel : kernelAry )
+        {
+            if( !NMatrixSimd::IsSupported( kernel ) )
+                continue;
+
+            NMatrixSimd::SetKernel( kernel );
+            const char * pKernelName = NMatrixSimd::GetKernelName( kernel );
+
+            if( !VerifyMultiply( NMatrixSimd::pMultiply, aVec[0], bVec[0] ) )
+            {
+                std::fprintf( stderr, "%s multiply kernel FAILED verification\n", pKernelName );
+                return 1;
+            }
+
+            Run( "multiply", pKernelName, batch, [&]( int count )
+            {
+                for( int i = 0; i < count; ++i )
+                    destVec[i] = aVec[i] * bVec[i];
+
+                sink = sink + destVec[count-1]()[0];
+            });
+
+            Run( "transform_batch", pKernelName, batch, [&]( int count )
+            {
+                aVec[0].TransformBatch( &destPointVec[0], &srcPointVec[0], count );
+
+                sink = sink + destPointVec[count-1].x;
+            });
+
+            Run( "inverse_full", pKernelName, batch, [&]( int count )
+            {
+                for( int i = 0; i < count; ++i )
+                {
+                    destVec[i] = aVec[i];
+                    destVec[i].InverseFull();
+                }
+
+                sink = sink + destVec[count-1]()[0];
+            });
+
+            Run( "quat_to_matrix", (std::string("NQuatSimd::ToMatrix/") + pKernelName).c_str(), batch, [&]( int count )
+            {
+                NQuatSimd::ToMatrix( &matrixAry[0], quatSoA, count );
+
+                sink = sink + matrixAry[((count-1)*16)+1];
+            });
+        }
+
+        NMatrixSimd::SetKernel( selectedKernel );
+
+        // Selected kernel benchmarks
+        Run( "transform", "per_point", batch, [&]( int count )
+        {
+            for( int i = 0; i < count; ++i )
+                aVec[0].Transform( destPointVec[i], srcPointVec[i] );
+
+            sink = sink + destPointVec[count-1].x;
+        });
+
+        Run( "inverse", "Inverse", batch, [&]( int count )
+        {
+            for( int i = 0; i < count; ++i )
+            {
+                destVec[i] = aVec[i];
+                destVec[i].Inverse();
+            }
+
+            sink = sink + destVec[count-1]()[0];
+        });
+
+        Run( "inverse", "InverseAffine", batch, [&]( int count )
+        {
+            for( int i = 0; i < count; ++i )
+            {
+                destVec[i] = aVec[i];
+                destVec[i].InverseAffine();
+            }
+
+            sink = sink + destVec[count-1]()[0];
+        });
+
+        Run( "quat_to_matrix", "CMatrix::Set", batch, [&]( int count )
+        {
+            for( int i = 0; i < count; ++i )
+            {
+                destVec[i].InitilizeMatrix();
+                destVec[i].Set( quatVec[i] );
+            }
+
+            sink = sink + destVec[count-1]()[1];
+        });
+
+        Run( "look_at", "LookAt", batch, [&]( int count )
+        {
+            for( int i = 0; i < count; ++i )
+                destVec[i].LookAt( cameraPos, targetVec[i], cameraUp );
+
+            sink = sink + destVec[count-1]()[0];
+        });
+
+        Run( "rotation", "Rotate", batch, [&]( int count )
+        {
+            for( int i = 0; i < count; ++i )
+            {
+                destVec[i].InitilizeMatrix();
+                destVec[i].Rotate( radianVec[i] );
+            }
+
+            sink = sink + destVec[count-1]()[0];
+        });
+
+        // Put the mode back after so the other benchmarks run in the default mode
+        const NFastMath::ESinCosMode savedMode = NFastMath::GetSinCosMode();
+        const NFastMath::ESinCosMode modeAry[] = { NFastMath::ESCM_EXACT, NFastMath::ESCM_POLY };
+        const char * modeNameAry[] = { "SetRotation/exact", "SetRotation/poly" };
+        const char * trsNameAry[] = { "SetTRS/exact", "SetTRS/poly" };
+
+        for( int mode = 0; mode < 2; ++mode )
+        {
+            NFastMath::SetSinCosMode( modeAry[mode] );
+
+            Run( "rotation", modeNameAry[mode], batch, [&]( int count )
+            {
+                for( int i = 0; i < count; ++i )
+                    destVec[i].SetRotation( radianVec[i] );
+
+                sink = sink + destVec[count-1]()[0];
+            });
+
+            Run( "rotation", trsNameAry[mode], batch, [&]( int count )
+            {
+                for( int i = 0; i < count; ++i )
+                    destVec[i].SetTRS( srcPointVec[i], radianVec[i], unitScale );
+
+                sink = sink + destVec[count-1]()[0];
+            });
+        }
+
+        NFastMath::SetSinCosMode( savedMode );
+    }
+
+    WriteJson( NMatrixSimd::GetKernelName( selectedKernel ) );
+
+    return 0;
+
+}   // main
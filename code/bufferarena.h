@@ -0,0 +1,70 @@
+/************************************************************************
+*    FILE NAME:       bufferarena.h
+*
+*    DESCRIPTION:     A GL buffer that meshes of a group are sub-allocated
+*                     from and the range of a mesh in it
+************************************************************************/
+
+#ifndef __buffer_arena_h__
+#define __buffer_arena_h__
+
+// Standard lib dependencies
+#include <cstddef>
+
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <SDL_opengl.h>
+#endif
+
+class CBufferRange
+{
+public:
+
+    CBufferRange() : id(0), offset(0)
+    {}
+
+    CBufferRange( GLuint _id, size_t _offset ) : id(_id), offset(_offset)
+    {}
+
+    // Buffer the range is in
+    GLuint id;
+
+    // Byte offset of the range in the buffer
+    size_t offset;
+};
+
+class CBufferArena
+{
+public:
+
+    CBufferArena() : id(0), size(0), used(0)
+    {}
+
+    CBufferArena( GLuint _id, size_t _size, size_t _used ) : id(_id), size(_size), used(_used)
+    {}
+
+    // Allocate a range aligned to the given bytes. Ranges are only freed
+    // with the whole arena.
+    bool Allocate( size_t bytes, size_t align, size_t & rOffset )
+    {
+        const size_t offset = ((used + align - 1) / align) * align;
+
+        if( offset + bytes > size )
+            return false;
+
+        rOffset = offset;
+        used = offset + bytes;
+
+        return true;
+    }
+
+    // GL buffer
+    GLuint id;
+
+    // Size of the buffer and the bytes allocated from it
+    size_t size;
+    size_t used;
+};
+
+#endif  // __buffer_arena_h__
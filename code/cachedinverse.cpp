@@ -0,0 +1,100 @@
+/************************************************************************
+*    FILE NAME:       cachedinverse.cpp
+*
+*    DESCRIPTION:     Opt-in cache for the inverse of a matrix that is
+*                     only recomputed when the matrix changes
+************************************************************************/
+
+// Physical component dependency
+#include <common/cachedinverse.h>
+
+// Standard lib dependencies
+#include <memory.h>
+
+/************************************************************************
+*    desc:  Constructor
+************************************************************************/
+CCachedInverse::CCachedInverse( EInverseType type ) :
+    m_type(type),
+    m_primed(false),
+    m_valid(false),
+    m_hitCount(0),
+    m_missCount(0)
+{
+    memset( m_source, 0, sizeof(m_source) );
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  Get the inverse of the matrix. The matrix is compared against
+*           the one the cached inverse came from, which is much cheaper
+*           than the inverse and can't miss a change the way a dirty
+*           flag on CMatrix could.
+*
+*    NOTE:  On a singular matrix the identity matrix is returned and
+*           IsValid returns false
+************************************************************************/
+const CMatrix & CCachedInverse::Get( const CMatrix & matrix )
+{
+    if( m_primed && (memcmp( m_source, matrix(), sizeof(m_source) ) == 0) )
+    {
+        ++m_hitCount;
+    }
+    else
+    {
+        ++m_missCount;
+
+        memcpy( m_source, matrix(), sizeof(m_source) );
+        m_primed = true;
+
+        m_inverse = matrix;
+
+        if( m_type == EIT_AFFINE )
+            m_valid = m_inverse.InverseAffine();
+        else
+            m_valid = m_inverse.InverseFull();
+
+        if( !m_valid )
+            m_inverse.InitilizeMatrix();
+    }
+
+    return m_inverse;
+
+}   // Get
+
+
+/************************************************************************
+*    desc:  Was the last computed inverse successful
+************************************************************************/
+bool CCachedInverse::IsValid() const
+{
+    return m_valid;
+
+}   // IsValid
+
+
+/************************************************************************
+*    desc:  Force the inverse to be recomputed on the next Get
+************************************************************************/
+void CCachedInverse::Invalidate()
+{
+    m_primed = false;
+
+}   // Invalidate
+
+
+/************************************************************************
+*    desc:  Get the cache stats
+************************************************************************/
+uint CCachedInverse::GetHitCount() const
+{
+    return m_hitCount;
+
+}   // GetHitCount
+
+uint CCachedInverse::GetMissCount() const
+{
+    return m_missCount;
+
+}   // GetMissCount
@@ -0,0 +1,63 @@
+/************************************************************************
+*    FILE NAME:       cachedinverse.h
+*
+*    DESCRIPTION:     Opt-in cache for the inverse of a matrix that is
+*                     only recomputed when the matrix changes
+************************************************************************/
+
+#ifndef __cached_inverse_h__
+#define __cached_inverse_h__
+
+// Game lib dependencies
+#include <common/matrix.h>
+#include <common/defs.h>
+
+class CCachedInverse
+{
+public:
+
+    enum EInverseType
+    {
+        EIT_FULL,
+        EIT_AFFINE,
+    };
+
+    // Constructor
+    CCachedInverse( EInverseType type = EIT_FULL );
+
+    // Get the inverse of the matrix. Only recomputed if the matrix changed
+    const CMatrix & Get( const CMatrix & matrix );
+
+    // Was the last computed inverse successful
+    bool IsValid() const;
+
+    // Force the inverse to be recomputed on the next Get
+    void Invalidate();
+
+    // Get the number of Get calls that used the cache or had to recompute
+    uint GetHitCount() const;
+    uint GetMissCount() const;
+
+private:
+
+    // Copy of the matrix the inverse was computed from
+    float m_source[16];
+
+    // The cached inverse
+    CMatrix m_inverse;
+
+    // Type of inverse to compute
+    EInverseType m_type;
+
+    // Has the source been set
+    bool m_primed;
+
+    // Did the last inverse succeed
+    bool m_valid;
+
+    // Cache stats
+    uint m_hitCount;
+    uint m_missCount;
+};
+
+#endif  // __cached_inverse_h__
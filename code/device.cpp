@@ -14,6 +14,11 @@
 // SDL lib dependencies
 #include <SDL_opengl.h>
 
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
 // Boost lib dependencies
 #include <boost/format.hpp>
 
@@ -22,6 +27,9 @@
 #include <utilities/settings.h>
 #include <utilities/genfunc.h>
 #include <common/size.h>
+#include <managers/glstatemanager.h>
+#include <managers/frameuniformmanager.h>
+#include <common/viewcull.h>
 
 /************************************************************************
 *    desc:  Constructor
@@ -63,6 +71,13 @@ void CDevice::Create()
     // Get the window size
     const CSize<int> size( CSettings::Instance().GetSize() );
 
+    #if defined(NULL_GL_BACKEND)
+    // The null GL backend renders nothing so there's no GL window or context.
+    // Use SDL's dummy video driver on machines without a display.
+    m_pWindow = SDL_CreateWindow( "", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, size.GetW(), size.GetH(), SDL_WINDOW_HIDDEN );
+    if( m_pWindow == nullptr )
+        throw NExcept::CCriticalException("Game window could not be created!", SDL_GetError() );
+    #else
     // Create window
     m_pWindow = SDL_CreateWindow( "", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, size.GetW(), size.GetH(), SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN );
     if( m_pWindow == nullptr )
@@ -72,6 +87,7 @@ void CDevice::Create()
     m_context = SDL_GL_CreateContext( m_pWindow );
     if( m_context == nullptr )
         throw NExcept::CCriticalException("OpenGL context could not be created!", SDL_GetError() );
+    #endif
 
     // Initialize GLEW
     glewExperimental = GL_TRUE;
@@ -89,7 +105,7 @@ void CDevice::Create()
 
     // Depth testing is off by default. Enable it?
     if( CSettings::Instance().GetEnableDepthBuffer() )
-        glEnable(GL_DEPTH_TEST);
+        CGLStateMgr::Instance().EnableDepthTest( true );
 
     // Create the projection matrixes
     CreateProjMatrix();
@@ -102,8 +118,10 @@ void CDevice::Create()
  ****************************************************************************/
 void CDevice::EnableVSync( bool enable )
 {
+    #if !defined(NULL_GL_BACKEND)
     if( SDL_GL_SetSwapInterval( (enable == true) ? 1 : 0 ) < 0 )
         NGenFunc::PostDebugMsg( boost::str( boost::format("Warning: Unable to set VSync! SDL GL Error: %s") % SDL_GetError() ) );
+    #endif
 
 }   // EnableVSync
 
@@ -129,6 +147,16 @@ void CDevice::CreateProjMatrix()
         CSettings::Instance().GetMinZdist(),
         CSettings::Instance().GetMaxZdist() );
 
+    // Shaders get the projections and screen size from the frame uniforms.
+    // The view projections are replaced when a camera is set.
+    CFrameUniformMgr & rFrameUniformMgr( CFrameUniformMgr::Instance() );
+    rFrameUniformMgr.SetViewProjMatrix( NDefs::EPT_PERSPECTIVE, m_perspectiveMatrix );
+    rFrameUniformMgr.SetViewProjMatrix( NDefs::EPT_ORTHOGRAPHIC, m_orthographicMatrix );
+    rFrameUniformMgr.SetScreenSize( CSettings::Instance().GetSize(), CSettings::Instance().GetDefaultSize() );
+
+    // The view culling caches the screen size and aspect ratio
+    CViewCull::Instance().Update();
+
 }   // CreateProjMatrix
 
 
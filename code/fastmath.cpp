@@ -0,0 +1,29 @@
+/************************************************************************
+*    FILE NAME:       fastmath.cpp
+*
+*    DESCRIPTION:     Fused sin/cos with a selectable precision
+************************************************************************/
+
+// Physical component dependency
+#include <common/fastmath.h>
+
+namespace NFastMath
+{
+    // Mode used by SinCos
+    ESinCosMode sinCosMode = ESCM_EXACT;
+
+    /************************************************************************
+    *    desc:  Set/Get the mode SinCos uses
+    ************************************************************************/
+    void SetSinCosMode( ESinCosMode mode )
+    {
+        sinCosMode = mode;
+
+    }   // SetSinCosMode
+
+    ESinCosMode GetSinCosMode()
+    {
+        return sinCosMode;
+
+    }   // GetSinCosMode
+}
@@ -0,0 +1,104 @@
+/************************************************************************
+*    FILE NAME:       fastmath.h
+*
+*    DESCRIPTION:     Fused sin/cos with a selectable precision
+************************************************************************/
+
+#ifndef __fast_math_h__
+#define __fast_math_h__
+
+// Standard lib dependencies
+#include <math.h>
+
+namespace NFastMath
+{
+    enum ESinCosMode
+    {
+        // Standard library sin and cos
+        ESCM_EXACT,
+
+        // Shared range reduction and minimax polynomials. Max absolute
+        // error is 1e-7 for |radian| <= 8192. Anything larger falls
+        // back to the exact mode.
+        ESCM_POLY,
+    };
+
+    // Mode used by SinCos. Defaults to ESCM_EXACT. glibc's sincosf is as
+    // fast as the polynomial so ESCM_POLY mostly pays off on platforms
+    // without a fused sincos in their math lib.
+    extern ESinCosMode sinCosMode;
+
+    // Largest angle the polynomial range reduction is accurate for
+    const float POLY_MAX_RADIAN = 8192.0f;
+
+    // Set/Get the mode SinCos uses
+    void SetSinCosMode( ESinCosMode mode );
+    ESinCosMode GetSinCosMode();
+
+    /************************************************************************
+    *    desc:  Standard library sin and cos
+    ************************************************************************/
+    inline void SinCosExact( float radian, float & sinOut, float & cosOut )
+    {
+        sinOut = sin( radian );
+        cosOut = cos( radian );
+
+    }   // SinCosExact
+
+    /************************************************************************
+    *    desc:  Polynomial sin and cos. The angle is reduced once to
+    *           +-pi/4 and both polynomials run on the reduced angle. The
+    *           quadrant then picks which result is the sin and the cos.
+    *           Coefficients are the single precision
+    *           minimax ones from the Cephes library.
+    ************************************************************************/
+    inline void SinCosPoly( float radian, float & sinOut, float & cosOut )
+    {
+        float x = fabs( radian );
+
+        if( x > POLY_MAX_RADIAN )
+        {
+            SinCosExact( radian, sinOut, cosOut );
+            return;
+        }
+
+        // Round up to an even octant so the reduced angle is +-pi/4
+        int octant = int(x * 1.27323954473516f);  // 4/pi
+        octant = (octant + 1) & ~1;
+
+        // Extended precision subtraction of the octant * pi/4
+        const float y = float(octant);
+        x = ((x - (y * 0.78515625f)) - (y * 2.4187564849853515625e-4f)) - (y * 3.77489497744594108e-8f);
+
+        const float z = x * x;
+
+        const float sinPoly = ((((-1.9515295891e-4f * z) + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x) + x;
+        const float cosPoly = ((((2.443315711809948e-5f * z) - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z) - (0.5f * z) + 1.0f;
+
+        // Pick and sign the results with table lookups instead of
+        // branches. The quadrant is effectively random for rotating
+        // objects so branches here mispredict about half the time.
+        static const float QUADRANT_SIGN[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+        const float polyAry[2] = { sinPoly, cosPoly };
+        const int quadrant = (octant >> 1) & 3;
+
+        // Odd quadrants swap the sin and cos. sin is odd, cos is even.
+        sinOut = copysign( 1.0f, radian ) * QUADRANT_SIGN[quadrant] * polyAry[quadrant & 1];
+        cosOut = QUADRANT_SIGN[(quadrant + 1) & 3] * polyAry[(quadrant & 1) ^ 1];
+
+    }   // SinCosPoly
+
+    /************************************************************************
+    *    desc:  Get the sin and cos of the angle with the selected mode
+    ************************************************************************/
+    inline void SinCos( float radian, float & sinOut, float & cosOut )
+    {
+        if( sinCosMode == ESCM_POLY )
+            SinCosPoly( radian, sinOut, cosOut );
+        else
+            SinCosExact( radian, sinOut, cosOut );
+
+    }   // SinCos
+}
+
+#endif  // __fast_math_h__
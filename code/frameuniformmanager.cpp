@@ -0,0 +1,154 @@
+/************************************************************************
+*    FILE NAME:       frameuniformmanager.cpp
+*
+*    DESCRIPTION:     Uniform buffer of the data that's the same for every
+*                     draw of a frame
+************************************************************************/
+
+#if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+// Glew dependencies (have to be defined first)
+#include <GL/glew.h>
+#endif
+
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
+// Physical component dependency
+#include <managers/frameuniformmanager.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+const char * CFrameUniformMgr::BLOCK_NAME = "frameData";
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CFrameUniformMgr::CFrameUniformMgr() :
+    m_ubo(0),
+    m_checked(false),
+    m_available(false)
+{
+    std::memset( &m_frameData, 0, sizeof(m_frameData) );
+
+    // Start with identity matrices
+    for( int i = 0; i < 16; i += 5 )
+    {
+        m_frameData.perspectiveViewProj[i] = 1.f;
+        m_frameData.orthographicViewProj[i] = 1.f;
+    }
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CFrameUniformMgr::~CFrameUniformMgr()
+{
+    if( m_ubo > 0 )
+        glDeleteBuffers(1, &m_ubo);
+
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Are uniform buffers supported. OpenGL ES 2.0 doesn't have them.
+************************************************************************/
+bool CFrameUniformMgr::IsAvailable()
+{
+    if( !m_checked )
+    {
+        m_checked = true;
+
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        m_available = GLEW_VERSION_3_1 || GLEW_ARB_uniform_buffer_object;
+        #endif
+    }
+
+    return m_available;
+
+}   // IsAvailable
+
+
+/************************************************************************
+*    desc:  Wire the program's frame block to the binding point
+*
+*    param: GLuint programID - linked program
+*
+*    ret:   bool - false if the program doesn't use the block
+************************************************************************/
+bool CFrameUniformMgr::BindBlock( GLuint programID )
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    if( IsAvailable() )
+    {
+        const GLuint blockIndex = glGetUniformBlockIndex( programID, BLOCK_NAME );
+
+        if( blockIndex != GL_INVALID_INDEX )
+        {
+            glUniformBlockBinding( programID, blockIndex, BINDING_POINT );
+            return true;
+        }
+    }
+    #endif
+
+    return false;
+
+}   // BindBlock
+
+
+/************************************************************************
+*    desc:  Set the view projection of a projection type
+************************************************************************/
+void CFrameUniformMgr::SetViewProjMatrix( NDefs::EProjectionType type, const CMatrix & matrix )
+{
+    if( type == NDefs::EPT_PERSPECTIVE )
+        std::memcpy( m_frameData.perspectiveViewProj, matrix(), sizeof(m_frameData.perspectiveViewProj) );
+    else
+        std::memcpy( m_frameData.orthographicViewProj, matrix(), sizeof(m_frameData.orthographicViewProj) );
+
+}   // SetViewProjMatrix
+
+
+/************************************************************************
+*    desc:  Set the window and default sizes
+************************************************************************/
+void CFrameUniformMgr::SetScreenSize( const CSize<float> & size, const CSize<float> & defaultSize )
+{
+    m_frameData.screenSize[0] = size.w;
+    m_frameData.screenSize[1] = size.h;
+    m_frameData.screenSize[2] = defaultSize.w;
+    m_frameData.screenSize[3] = defaultSize.h;
+
+}   // SetScreenSize
+
+
+/************************************************************************
+*    desc:  Add the elapsed time, upload the frame data and bind the
+*           buffer. The binding point is shared by all programs so
+*           nothing has to be sent per draw.
+************************************************************************/
+void CFrameUniformMgr::Update( float elapsedTime )
+{
+    if( !IsAvailable() )
+        return;
+
+    m_frameData.time[0] += elapsedTime;
+    m_frameData.time[1] = elapsedTime;
+
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    if( m_ubo == 0 )
+        glGenBuffers( 1, &m_ubo );
+
+    // The uniform buffer target isn't part of the tracked state.
+    // Orphan last frame's data so the driver doesn't have to wait on it.
+    glBindBuffer( GL_UNIFORM_BUFFER, m_ubo );
+    glBufferData( GL_UNIFORM_BUFFER, sizeof(m_frameData), nullptr, GL_STREAM_DRAW );
+    glBufferSubData( GL_UNIFORM_BUFFER, 0, sizeof(m_frameData), &m_frameData );
+    glBindBufferBase( GL_UNIFORM_BUFFER, BINDING_POINT, m_ubo );
+    #endif
+
+}   // Update
@@ -0,0 +1,95 @@
+/************************************************************************
+*    FILE NAME:       frameuniformmanager.h
+*
+*    DESCRIPTION:     Uniform buffer of the data that's the same for every
+*                     draw of a frame. The buffer is uploaded and bound
+*                     once per frame. Shaders read it through the uniform
+*                     block below, which the shader manager wires to the
+*                     binding point when the program is linked.
+*
+*                     layout(std140) uniform frameData
+*                     {
+*                         mat4 perspectiveViewProjMatrix;
+*                         mat4 orthographicViewProjMatrix;
+*                         vec4 time;        // x = total, y = elapsed
+*                         vec4 screenSize;  // xy = window, zw = default
+*                     };
+************************************************************************/
+
+#ifndef __frame_uniform_manager_h__
+#define __frame_uniform_manager_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <common/size.h>
+#include <common/matrix.h>
+
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <SDL_opengl.h>
+#endif
+
+class CFrameUniformMgr
+{
+public:
+
+    // Name of the uniform block in the shaders and the binding point it's wired to
+    static const char * BLOCK_NAME;
+    static const GLuint BINDING_POINT = 0;
+
+    // Get the instance of the singleton class
+    static CFrameUniformMgr & Instance()
+    {
+        static CFrameUniformMgr frameUniformMgr;
+        return frameUniformMgr;
+    }
+
+    // Are uniform buffers supported. Needs a GL context.
+    bool IsAvailable();
+
+    // Wire the program's frame block to the binding point. Called after the
+    // program is linked. Returns false if the program doesn't use the block.
+    bool BindBlock( GLuint programID );
+
+    // Set the view projection of a projection type
+    void SetViewProjMatrix( NDefs::EProjectionType type, const CMatrix & matrix );
+
+    // Set the window and default sizes
+    void SetScreenSize( const CSize<float> & size, const CSize<float> & defaultSize );
+
+    // Add the elapsed time, upload the frame data and bind the buffer.
+    // Call once per frame before rendering.
+    void Update( float elapsedTime );
+
+private:
+
+    // Constructor
+    CFrameUniformMgr();
+
+    // Destructor
+    ~CFrameUniformMgr();
+
+private:
+
+    // Frame data in the std140 layout of the block
+    class CFrameData
+    {
+    public:
+        float perspectiveViewProj[16];
+        float orthographicViewProj[16];
+        float time[4];
+        float screenSize[4];
+    };
+
+    CFrameData m_frameData;
+
+    // Uniform buffer
+    GLuint m_ubo;
+
+    // Has the driver been checked and the result
+    bool m_checked;
+    bool m_available;
+};
+
+#endif  // __frame_uniform_manager_h__
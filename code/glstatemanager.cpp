@@ -0,0 +1,428 @@
+/************************************************************************
+*    FILE NAME:       glstatemanager.cpp
+*
+*    DESCRIPTION:     Tracks the OpenGL bind and enable state so a state
+*                     change that wouldn't change anything isn't sent to
+*                     GL. Counts the issued and elided changes per frame.
+************************************************************************/
+
+#if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+// Glew dependencies (have to be defined first)
+#include <GL/glew.h>
+#endif
+
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
+// Physical component dependency
+#include <managers/glstatemanager.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CGLStateMgr::CGLStateMgr() :
+    m_vaoID(0)
+{
+    Reset();
+
+    std::memset( m_issued, 0, sizeof(m_issued) );
+    std::memset( m_elided, 0, sizeof(m_elided) );
+    std::memset( m_lastIssued, 0, sizeof(m_lastIssued) );
+    std::memset( m_lastElided, 0, sizeof(m_lastElided) );
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CGLStateMgr::~CGLStateMgr()
+{
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Forget everything so the next request of each state is sent
+*           to GL. The VAO is put back to the default instead of being
+*           forgotten because GLES2 doesn't have glBindVertexArray and
+*           the other buffer binds depend on which VAO is bound.
+************************************************************************/
+void CGLStateMgr::Reset()
+{
+    if( m_vaoID != 0 )
+    {
+        m_vaoID = 0;
+
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        glBindVertexArray( 0 );
+        #endif
+    }
+
+    m_programID = UNKNOWN;
+    m_vboID = UNKNOWN;
+    m_iboID = UNKNOWN;
+    m_defaultIBOID = UNKNOWN;
+
+    m_activeUnit = UNKNOWN;
+    for( uint i = 0; i < MAX_TEXTURE_UNITS; ++i )
+        m_textureID[i] = UNKNOWN;
+
+    m_blend = -1;
+    m_depthTest = -1;
+    m_depthMask = -1;
+    m_scissorTest = -1;
+    m_cullFace = -1;
+
+    m_blendSrc = UNKNOWN;
+    m_blendDest = UNKNOWN;
+    m_depthFunc = UNKNOWN;
+
+    m_scissorKnown = false;
+
+}   // Reset
+
+
+/************************************************************************
+*    desc:  Count the change and return if it needs to be sent to GL
+************************************************************************/
+bool CGLStateMgr::IsChanged( EStateType type, bool changed )
+{
+    if( changed )
+        ++m_issued[type];
+    else
+        ++m_elided[type];
+
+    return changed;
+
+}   // IsChanged
+
+
+/************************************************************************
+*    desc:  Shader program
+************************************************************************/
+void CGLStateMgr::UseProgram( GLuint programID )
+{
+    if( IsChanged( EST_PROGRAM, m_programID != programID ) )
+    {
+        m_programID = programID;
+        glUseProgram( programID );
+    }
+
+}   // UseProgram
+
+
+/************************************************************************
+*    desc:  Buffers
+************************************************************************/
+void CGLStateMgr::BindVBO( GLuint vboID )
+{
+    if( IsChanged( EST_VBO, m_vboID != vboID ) )
+    {
+        m_vboID = vboID;
+        glBindBuffer( GL_ARRAY_BUFFER, vboID );
+    }
+
+}   // BindVBO
+
+void CGLStateMgr::BindIBO( GLuint iboID )
+{
+    if( IsChanged( EST_IBO, m_iboID != iboID ) )
+    {
+        m_iboID = iboID;
+        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
+    }
+
+}   // BindIBO
+
+
+/************************************************************************
+*    desc:  Bind a VAO. The IBO binding is part of the VAO so the
+*           tracked IBO follows the VAO.
+*
+*    param: GLuint vaoID - VAO to bind
+*           GLuint iboID - IBO saved in the VAO. Not used for VAO 0.
+************************************************************************/
+void CGLStateMgr::BindVAO( GLuint vaoID, GLuint iboID )
+{
+    if( IsChanged( EST_VAO, m_vaoID != vaoID ) )
+    {
+        // Save the IBO of the default VAO to restore when it's bound again
+        if( m_vaoID == 0 )
+            m_defaultIBOID = m_iboID;
+
+        m_iboID = (vaoID == 0) ? m_defaultIBOID : iboID;
+        m_vaoID = vaoID;
+
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        glBindVertexArray( vaoID );
+        #endif
+    }
+
+}   // BindVAO
+
+
+/************************************************************************
+*    desc:  Bind a 2D texture to a texture unit
+************************************************************************/
+void CGLStateMgr::ActiveTexture( uint unit )
+{
+    if( IsChanged( EST_ACTIVE_TEXTURE, m_activeUnit != unit ) )
+    {
+        m_activeUnit = unit;
+        glActiveTexture( GL_TEXTURE0 + unit );
+    }
+
+}   // ActiveTexture
+
+void CGLStateMgr::BindTexture( GLuint textureID, uint unit )
+{
+    if( IsChanged( EST_TEXTURE, m_textureID[unit] != textureID ) )
+    {
+        ActiveTexture( unit );
+
+        m_textureID[unit] = textureID;
+        glBindTexture( GL_TEXTURE_2D, textureID );
+    }
+
+}   // BindTexture
+
+
+/************************************************************************
+*    desc:  Enable or disable a capability
+************************************************************************/
+void CGLStateMgr::SetCapability( EStateType type, GLenum cap, int & rState, bool enable )
+{
+    const int state = enable ? 1 : 0;
+
+    if( IsChanged( type, rState != state ) )
+    {
+        rState = state;
+
+        if( enable )
+            glEnable( cap );
+        else
+            glDisable( cap );
+    }
+
+}   // SetCapability
+
+
+/************************************************************************
+*    desc:  Blend state
+************************************************************************/
+void CGLStateMgr::EnableBlend( bool enable )
+{
+    SetCapability( EST_BLEND, GL_BLEND, m_blend, enable );
+
+}   // EnableBlend
+
+void CGLStateMgr::BlendFunc( GLenum srcFactor, GLenum destFactor )
+{
+    if( IsChanged( EST_BLEND_FUNC, (m_blendSrc != srcFactor) || (m_blendDest != destFactor) ) )
+    {
+        m_blendSrc = srcFactor;
+        m_blendDest = destFactor;
+        glBlendFunc( srcFactor, destFactor );
+    }
+
+}   // BlendFunc
+
+
+/************************************************************************
+*    desc:  Depth state
+************************************************************************/
+void CGLStateMgr::EnableDepthTest( bool enable )
+{
+    SetCapability( EST_DEPTH_TEST, GL_DEPTH_TEST, m_depthTest, enable );
+
+}   // EnableDepthTest
+
+void CGLStateMgr::DepthMask( bool enable )
+{
+    const int state = enable ? 1 : 0;
+
+    if( IsChanged( EST_DEPTH_MASK, m_depthMask != state ) )
+    {
+        m_depthMask = state;
+        glDepthMask( enable ? GL_TRUE : GL_FALSE );
+    }
+
+}   // DepthMask
+
+void CGLStateMgr::DepthFunc( GLenum func )
+{
+    if( IsChanged( EST_DEPTH_FUNC, m_depthFunc != func ) )
+    {
+        m_depthFunc = func;
+        glDepthFunc( func );
+    }
+
+}   // DepthFunc
+
+
+/************************************************************************
+*    desc:  Scissor state
+************************************************************************/
+void CGLStateMgr::EnableScissorTest( bool enable )
+{
+    SetCapability( EST_SCISSOR_TEST, GL_SCISSOR_TEST, m_scissorTest, enable );
+
+}   // EnableScissorTest
+
+void CGLStateMgr::Scissor( GLint x, GLint y, GLsizei w, GLsizei h )
+{
+    const bool changed = !m_scissorKnown ||
+        (m_scissor[0] != x) || (m_scissor[1] != y) || (m_scissor[2] != w) || (m_scissor[3] != h);
+
+    if( IsChanged( EST_SCISSOR_RECT, changed ) )
+    {
+        m_scissorKnown = true;
+        m_scissor[0] = x;
+        m_scissor[1] = y;
+        m_scissor[2] = w;
+        m_scissor[3] = h;
+
+        glScissor( x, y, w, h );
+    }
+
+}   // Scissor
+
+
+/************************************************************************
+*    desc:  Cull state
+************************************************************************/
+void CGLStateMgr::EnableCullFace( bool enable )
+{
+    SetCapability( EST_CULL_FACE, GL_CULL_FACE, m_cullFace, enable );
+
+}   // EnableCullFace
+
+
+/************************************************************************
+*    desc:  Forget deleted objects that are bound
+************************************************************************/
+void CGLStateMgr::OnDeleteProgram( GLuint programID )
+{
+    // A deleted program stays in use until another is used so
+    // only forget it so the next use of the name is sent
+    if( m_programID == programID )
+        m_programID = UNKNOWN;
+
+}   // OnDeleteProgram
+
+void CGLStateMgr::OnDeleteBuffer( GLuint bufferID )
+{
+    if( m_vboID == bufferID )
+        m_vboID = 0;
+
+    if( m_iboID == bufferID )
+        m_iboID = 0;
+
+    if( m_defaultIBOID == bufferID )
+        m_defaultIBOID = 0;
+
+}   // OnDeleteBuffer
+
+void CGLStateMgr::OnDeleteVAO( GLuint vaoID )
+{
+    if( m_vaoID == vaoID )
+    {
+        m_vaoID = 0;
+        m_iboID = m_defaultIBOID;
+    }
+
+}   // OnDeleteVAO
+
+void CGLStateMgr::OnDeleteTexture( GLuint textureID )
+{
+    for( uint i = 0; i < MAX_TEXTURE_UNITS; ++i )
+    {
+        if( m_textureID[i] == textureID )
+            m_textureID[i] = 0;
+    }
+
+}   // OnDeleteTexture
+
+
+/************************************************************************
+*    desc:  Get what's bound
+************************************************************************/
+GLuint CGLStateMgr::GetProgram() const
+{
+    return m_programID;
+
+}   // GetProgram
+
+GLuint CGLStateMgr::GetVBO() const
+{
+    return m_vboID;
+
+}   // GetVBO
+
+GLuint CGLStateMgr::GetIBO() const
+{
+    return m_iboID;
+
+}   // GetIBO
+
+GLuint CGLStateMgr::GetVAO() const
+{
+    return m_vaoID;
+
+}   // GetVAO
+
+
+/************************************************************************
+*    desc:  Save this frame's counts and clear them for the next frame
+************************************************************************/
+void CGLStateMgr::EndFrame()
+{
+    std::memcpy( m_lastIssued, m_issued, sizeof(m_issued) );
+    std::memcpy( m_lastElided, m_elided, sizeof(m_elided) );
+    std::memset( m_issued, 0, sizeof(m_issued) );
+    std::memset( m_elided, 0, sizeof(m_elided) );
+
+}   // EndFrame
+
+
+/************************************************************************
+*    desc:  Last frame's counts of changes sent to GL and changes skipped
+************************************************************************/
+int CGLStateMgr::GetIssuedCount( EStateType type ) const
+{
+    return m_lastIssued[type];
+
+}   // GetIssuedCount
+
+int CGLStateMgr::GetElidedCount( EStateType type ) const
+{
+    return m_lastElided[type];
+
+}   // GetElidedCount
+
+int CGLStateMgr::GetIssuedCount() const
+{
+    int count = 0;
+
+    for( int i = 0; i < EST_MAX; ++i )
+        count += m_lastIssued[i];
+
+    return count;
+
+}   // GetIssuedCount
+
+int CGLStateMgr::GetElidedCount() const
+{
+    int count = 0;
+
+    for( int i = 0; i < EST_MAX; ++i )
+        count += m_lastElided[i];
+
+    return count;
+
+}   // GetElidedCount
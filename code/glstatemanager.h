@@ -0,0 +1,166 @@
+/************************************************************************
+*    FILE NAME:       glstatemanager.h
+*
+*    DESCRIPTION:     Tracks the OpenGL bind and enable state so a state
+*                     change that wouldn't change anything isn't sent to
+*                     GL. All binds go through here so there's one place
+*                     that knows what's bound and one place to reset it.
+*                     Counts the issued and elided changes per frame.
+************************************************************************/
+
+#ifndef __gl_state_manager_h__
+#define __gl_state_manager_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <SDL_opengl.h>
+#endif
+
+class CGLStateMgr
+{
+public:
+
+    enum EStateType
+    {
+        EST_PROGRAM,
+        EST_VBO,
+        EST_IBO,
+        EST_VAO,
+        EST_ACTIVE_TEXTURE,
+        EST_TEXTURE,
+        EST_BLEND,
+        EST_BLEND_FUNC,
+        EST_DEPTH_TEST,
+        EST_DEPTH_MASK,
+        EST_DEPTH_FUNC,
+        EST_SCISSOR_TEST,
+        EST_SCISSOR_RECT,
+        EST_CULL_FACE,
+        EST_MAX
+    };
+
+    // Number of texture units tracked
+    static const uint MAX_TEXTURE_UNITS = 8;
+
+    // Get the instance of the singleton class
+    static CGLStateMgr & Instance()
+    {
+        static CGLStateMgr glStateMgr;
+        return glStateMgr;
+    }
+
+    // Forget everything so the next request of each state is sent to GL.
+    // Call after anything outside of the engine has changed the GL state.
+    void Reset();
+
+    // Shader program
+    void UseProgram( GLuint programID );
+
+    // Buffers. The IBO binding belongs to the bound VAO.
+    void BindVBO( GLuint vboID );
+    void BindIBO( GLuint iboID );
+
+    // Bind a VAO. iboID is the IBO saved in the VAO. Binding VAO 0
+    // restores the IBO that was bound to the default VAO.
+    void BindVAO( GLuint vaoID, GLuint iboID );
+
+    // Bind a 2D texture to a texture unit
+    void BindTexture( GLuint textureID, uint unit = 0 );
+
+    // Blend state
+    void EnableBlend( bool enable );
+    void BlendFunc( GLenum srcFactor, GLenum destFactor );
+
+    // Depth state
+    void EnableDepthTest( bool enable );
+    void DepthMask( bool enable );
+    void DepthFunc( GLenum func );
+
+    // Scissor state
+    void EnableScissorTest( bool enable );
+    void Scissor( GLint x, GLint y, GLsizei w, GLsizei h );
+
+    // Cull state
+    void EnableCullFace( bool enable );
+
+    // GL drops the binding of a deleted object. Call these after the
+    // delete so the name isn't taken as still bound when it's reused.
+    void OnDeleteProgram( GLuint programID );
+    void OnDeleteBuffer( GLuint bufferID );
+    void OnDeleteVAO( GLuint vaoID );
+    void OnDeleteTexture( GLuint textureID );
+
+    // Get what's bound
+    GLuint GetProgram() const;
+    GLuint GetVBO() const;
+    GLuint GetIBO() const;
+    GLuint GetVAO() const;
+
+    // Save this frame's counts and clear them for the next frame
+    void EndFrame();
+
+    // Last frame's counts of changes sent to GL and changes skipped
+    int GetIssuedCount( EStateType type ) const;
+    int GetElidedCount( EStateType type ) const;
+    int GetIssuedCount() const;
+    int GetElidedCount() const;
+
+private:
+
+    // Constructor
+    CGLStateMgr();
+
+    // Destructor
+    ~CGLStateMgr();
+
+    // Count the change and return if it needs to be sent to GL
+    bool IsChanged( EStateType type, bool changed );
+
+    // Enable or disable a capability
+    void SetCapability( EStateType type, GLenum cap, int & rState, bool enable );
+
+    // Make the texture unit active
+    void ActiveTexture( uint unit );
+
+private:
+
+    // Value of a state that isn't known
+    static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+    GLuint m_programID;
+    GLuint m_vboID;
+    GLuint m_iboID;
+    GLuint m_vaoID;
+
+    // IBO bound to the default VAO while another VAO is bound
+    GLuint m_defaultIBOID;
+
+    uint m_activeUnit;
+    GLuint m_textureID[MAX_TEXTURE_UNITS];
+
+    // Capabilities. -1 is unknown.
+    int m_blend;
+    int m_depthTest;
+    int m_depthMask;
+    int m_scissorTest;
+    int m_cullFace;
+
+    GLenum m_blendSrc;
+    GLenum m_blendDest;
+    GLenum m_depthFunc;
+
+    bool m_scissorKnown;
+    GLint m_scissor[4];
+
+    // Counts of the current and last frame
+    int m_issued[EST_MAX];
+    int m_elided[EST_MAX];
+    int m_lastIssued[EST_MAX];
+    int m_lastElided[EST_MAX];
+};
+
+#endif  // __gl_state_manager_h__
@@ -0,0 +1,89 @@
+/************************************************************************
+*    FILE NAME:       glyphtable.cpp
+*
+*    DESCRIPTION:     Character data of a font indexed by code point
+************************************************************************/
+
+// Physical component dependency
+#include <common/glyphtable.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CGlyphTable::CGlyphTable() :
+    m_flatVec( FLAT_SIZE, nullptr ),
+    m_pDefault(nullptr)
+{
+}   // constructor
+
+
+/************************************************************************
+*    desc:  Add the character data of a code point
+************************************************************************/
+void CGlyphTable::Add( uint32_t codePoint, const CCharData & charData )
+{
+    if( codePoint < FLAT_SIZE )
+        m_flatVec[codePoint] = &charData;
+    else
+        m_hashedMap[codePoint] = &charData;
+
+}   // Add
+
+
+/************************************************************************
+*    desc:  Set the code point used for characters the font doesn't have
+************************************************************************/
+void CGlyphTable::SetDefault( uint32_t codePoint )
+{
+    m_pDefault = Find( codePoint );
+
+}   // SetDefault
+
+
+/************************************************************************
+*    desc:  Find in the hashed code points
+************************************************************************/
+const CCharData * CGlyphTable::FindHashed( uint32_t codePoint ) const
+{
+    auto iter = m_hashedMap.find( codePoint );
+    if( iter != m_hashedMap.end() )
+        return iter->second;
+
+    return nullptr;
+
+}   // FindHashed
+
+
+/************************************************************************
+*    desc:  Get the default character data
+************************************************************************/
+const CCharData & CGlyphTable::GetDefault( uint32_t codePoint ) const
+{
+    if( m_pDefault == nullptr )
+    {
+        throw NExcept::CCriticalException("Font Error!",
+            boost::str( boost::format("Font doesn't have the character (U+%04X) and there's no default.\n\n%s\nLine: %s")
+                % codePoint % __FUNCTION__ % __LINE__ ));
+    }
+
+    return *m_pDefault;
+
+}   // GetDefault
+
+
+/************************************************************************
+*    desc:  Remove all the character data
+************************************************************************/
+void CGlyphTable::Clear()
+{
+    m_flatVec.assign( FLAT_SIZE, nullptr );
+    m_hashedMap.clear();
+    m_pDefault = nullptr;
+
+}   // Clear
@@ -0,0 +1,88 @@
+/************************************************************************
+*    FILE NAME:       glyphtable.h
+*
+*    DESCRIPTION:     Character data of a font indexed by code point.
+*                     The common range is a flat table indexed directly
+*                     and the rest is hashed, so a lookup never searches.
+*
+*                     The table points into the character data of it's
+*                     owner so it can't be copied or moved. An owner that
+*                     is copied or moved has to rebuild it's table.
+************************************************************************/
+
+#ifndef __glyph_table_h__
+#define __glyph_table_h__
+
+// Standard lib dependencies
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Forward declaration(s)
+class CCharData;
+
+class CGlyphTable
+{
+public:
+
+    // Code points below this are in the flat table. Covers the one
+    // and two byte UTF-8 range, ie Latin, Greek and Cyrillic.
+    static const uint32_t FLAT_SIZE = 0x800;
+
+    // Constructor
+    CGlyphTable();
+
+    // The pointers would still point into the source's character data
+    CGlyphTable( const CGlyphTable & ) = delete;
+    CGlyphTable & operator = ( const CGlyphTable & ) = delete;
+    CGlyphTable( CGlyphTable && ) = delete;
+    CGlyphTable & operator = ( CGlyphTable && ) = delete;
+
+    // Add the character data of a code point. The data has to stay
+    // alive and in place as long as the table.
+    void Add( uint32_t codePoint, const CCharData & charData );
+
+    // Set the code point used for characters the font doesn't have
+    void SetDefault( uint32_t codePoint );
+
+    // Find the character data. Returns nullptr if the font doesn't have it.
+    const CCharData * Find( uint32_t codePoint ) const
+    {
+        if( codePoint < FLAT_SIZE )
+            return m_flatVec[codePoint];
+
+        return FindHashed( codePoint );
+    }
+
+    // Get the character data. Characters the font doesn't have get
+    // the default character.
+    const CCharData & GetCharData( uint32_t codePoint ) const
+    {
+        const CCharData * pCharData = Find( codePoint );
+        if( pCharData != nullptr )
+            return *pCharData;
+
+        return GetDefault( codePoint );
+    }
+
+    // Remove all the character data
+    void Clear();
+
+private:
+
+    // Find in the hashed code points
+    const CCharData * FindHashed( uint32_t codePoint ) const;
+
+    // Get the default character data
+    const CCharData & GetDefault( uint32_t codePoint ) const;
+
+private:
+
+    std::vector<const CCharData *> m_flatVec;
+    std::unordered_map<uint32_t, const CCharData *> m_hashedMap;
+
+    // Character used when the font doesn't have one
+    const CCharData * m_pDefault;
+};
+
+#endif  // __glyph_table_h__
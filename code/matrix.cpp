@@ -19,6 +19,8 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
 #include <common/defs.h>
+#include <common/matrixsimd.h>
+#include <common/fastmath.h>
 
 // Turn off the data type conversion warning (ie. int to float, float to int etc.)
 // We do this all the time in 3D. Don't need to be bugged by it all the time.
@@ -111,21 +113,7 @@ void CMatrix::ClearTranlate()
 ************************************************************************/  
 void CMatrix::MergeMatrix( const float mat[mMax] )
 {
-    float temp[mMax];
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        { 
-            temp[(i*4)+j] = (matrix[i*4]	 * mat[j])
-                          + (matrix[(i*4)+1] * mat[4+j])
-                          + (matrix[(i*4)+2] * mat[8+j])
-                          + (matrix[(i*4)+3] * mat[12+j]);
-        }
-    }
-
-    // Copy temp to master Matrix
-    memcpy( matrix, temp, sizeof(temp) );
+    NMatrixSimd::Multiply( matrix, matrix, mat );
 
 }  // MergeMatrix
 
@@ -137,21 +125,7 @@ void CMatrix::MergeMatrix( const float mat[mMax] )
 ************************************************************************/  
 void CMatrix::ReverseMergeMatrix( const float mat[mMax] )
 {
-    float temp[mMax];
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        { 
-            temp[(i*4)+j] = (mat[i*4]     * matrix[j])
-                          + (mat[(i*4)+1] * matrix[4+j])
-                          + (mat[(i*4)+2] * matrix[8+j])
-                          + (mat[(i*4)+3] * matrix[12+j]);
-        }
-    }
-
-    // Copy temp to master Matrix
-    memcpy( matrix, temp, sizeof(temp) );
+    NMatrixSimd::Multiply( matrix, mat, matrix );
 
 }  // MergeMatrix
 
@@ -164,21 +138,7 @@ void CMatrix::ReverseMergeMatrix( const float mat[mMax] )
 ************************************************************************/
 void CMatrix::MergeMatrices( float dest[mMax], const float source[mMax] )
 {
-    float temp[mMax];
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        {
-            temp[ (i*4)+j ] = ( source[ i*4 ]	  * dest[ j ] )
-                            + ( source[ (i*4)+1 ] * dest[ 4+j ] )
-                            + ( source[ (i*4)+2 ] * dest[ 8+j ] )
-                            + ( source[ (i*4)+3 ] * dest[ 12+j ] );
-        }
-    }
-
-    // Copy Temp to Dest
-    memcpy( dest, temp, sizeof(temp) );
+    NMatrixSimd::Multiply( dest, source, dest );
 
 }   // MergeMatrices
 
@@ -208,37 +168,151 @@ void CMatrix::Rotate( const CPoint & point )
 ************************************************************************/
 void CMatrix::Rotate( const CRadian & radian )
 {
-    int flags = NO_ROT;
     float rMatrix[ 16 ];
 
-    // init the rotation matrix
-    InitIdentityMatrix( rMatrix );
+    // Build the rotation matrix in one shot
+    EulerToMatrix( rMatrix, radian );
 
-    // Apply Z rotation
-    if( radian.z != 0.0f )
-    {
-        RotateZRad( rMatrix, radian.z, flags );
-        flags |= ROT_Z;
-    }
-    
-    // Apply Y rotation
-    if( radian.y != 0.0f )
+    // Merg the rotation into the master matrix
+    MergeMatrix( rMatrix );
+
+}   // Rotate
+
+
+/************************************************************************
+*    desc:  Set the matrix to the rotation. Same result as
+*           InitilizeMatrix and Rotate.
+*
+*    param: const CRadian & radian - rotation
+************************************************************************/
+void CMatrix::SetRotation( const CRadian & radian )
+{
+    EulerToMatrix( matrix, radian );
+
+}   // SetRotation
+
+
+/************************************************************************
+*    desc:  Build the rotation matrix for all three axes in one shot.
+*           Rotation is applied Z, Y then X, same as the RotateXRad,
+*           RotateYRad and RotateZRad chain.
+*
+*    param: float dest[mMax] - destination matrix
+*           const CRadian & radian - rotation
+************************************************************************/
+void CMatrix::EulerToMatrix( float dest[mMax], const CRadian & radian )
+{
+    float sinX, cosX, sinY, cosY, sinZ, cosZ;
+    NFastMath::SinCos( radian.x, sinX, cosX );
+    NFastMath::SinCos( radian.y, sinY, cosY );
+    NFastMath::SinCos( radian.z, sinZ, cosZ );
+
+    dest[0]  = cosY * cosZ;
+    dest[1]  = cosY * sinZ;
+    dest[2]  = -sinY;
+    dest[3]  = 0.0f;
+
+    dest[4]  = (sinX * sinY * cosZ) - (cosX * sinZ);
+    dest[5]  = (sinX * sinY * sinZ) + (cosX * cosZ);
+    dest[6]  = sinX * cosY;
+    dest[7]  = 0.0f;
+
+    dest[8]  = (cosX * sinY * cosZ) + (sinX * sinZ);
+    dest[9]  = (cosX * sinY * sinZ) - (sinX * cosZ);
+    dest[10] = cosX * cosY;
+    dest[11] = 0.0f;
+
+    dest[12] = 0.0f;
+    dest[13] = 0.0f;
+    dest[14] = 0.0f;
+    dest[15] = 1.0f;
+
+}   // EulerToMatrix
+
+
+/************************************************************************
+*    desc:  Build the scale, rotate and translate matrix in one pass.
+*           Gives the same result as InitilizeMatrix, Scale, Rotate and
+*           Translate without the identity init and full 4x4 merges.
+*
+*    param: const CPoint & pos - translation
+*           const CRadian & radian - rotation
+*           const CPoint & scale - scale
+************************************************************************/
+void CMatrix::SetTRS( const CPoint & pos, const CRadian & radian, const CPoint & scale )
+{
+    EulerToMatrix( matrix, radian );
+
+    // Each row is scaled by the matching scale axis
+    for( int i = 0; i < 3; ++i )
     {
-        RotateYRad( rMatrix, radian.y, flags );
-        flags |= ROT_Y;
+        matrix[i]   *= scale.x;
+        matrix[4+i] *= scale.y;
+        matrix[8+i] *= scale.z;
     }
 
-    // Apply X rotation
-    if( radian.x != 0.0f )
+    matrix[12] = pos.x;
+    matrix[13] = pos.y;
+    matrix[14] = pos.z;
+
+}   // SetTRS
+
+
+/************************************************************************
+*    desc:  Build the 2D scale, rotate and translate matrix in one pass.
+*           2D objects only rotate around the z axis.
+*
+*    param: const CPoint & pos - translation
+*           float radianZ - rotation around the z axis
+*           const CPoint & scale - scale
+************************************************************************/
+void CMatrix::SetTRS( const CPoint & pos, float radianZ, const CPoint & scale )
+{
+    float sinZ, cosZ;
+    NFastMath::SinCos( radianZ, sinZ, cosZ );
+
+    matrix[0]  = scale.x * cosZ;
+    matrix[1]  = scale.x * sinZ;
+    matrix[2]  = 0.0f;
+    matrix[3]  = 0.0f;
+
+    matrix[4]  = scale.y * -sinZ;
+    matrix[5]  = scale.y * cosZ;
+    matrix[6]  = 0.0f;
+    matrix[7]  = 0.0f;
+
+    matrix[8]  = 0.0f;
+    matrix[9]  = 0.0f;
+    matrix[10] = scale.z;
+    matrix[11] = 0.0f;
+
+    matrix[12] = pos.x;
+    matrix[13] = pos.y;
+    matrix[14] = pos.z;
+    matrix[15] = 1.0f;
+
+}   // SetTRS
+
+
+/************************************************************************
+*    desc:  Set this matrix to a scale matrix merged with another matrix.
+*           Same as InitilizeMatrix, Scale and *= but only scales the
+*           first three rows instead of doing a full 4x4 merge.
+*
+*    param: const CPoint & scale - scale
+*           const CMatrix & obj - matrix to merge with
+************************************************************************/
+void CMatrix::SetScaleMerge( const CPoint & scale, const CMatrix & obj )
+{
+    for( int i = 0; i < 4; ++i )
     {
-        RotateXRad( rMatrix, radian.x, flags );
-        flags |= ROT_X;
+        matrix[i]    = obj.matrix[i]    * scale.x;
+        matrix[4+i]  = obj.matrix[4+i]  * scale.y;
+        matrix[8+i]  = obj.matrix[8+i]  * scale.z;
+        matrix[12+i] = obj.matrix[12+i];
     }
 
-    // Merg the rotation into the master matrix
-    MergeMatrix( rMatrix );
-
-}   // Rotate
+}   // SetScaleMerge
 
 
 /************************************************************************
@@ -467,6 +541,57 @@ void CMatrix::Transform( CQuad & dest, const CQuad & source ) const
 }   // Transform
 
 
+/************************************************************************
+*    desc:  Transform an array of points in one call. Uses the SIMD
+*           kernels so four points go through per instruction.
+*
+*    param: CPoint * pDest - destination points
+*           const CPoint * pSource - source points
+*           int count - number of points
+************************************************************************/
+void CMatrix::TransformBatch( CPoint * pDest, const CPoint * pSource, int count ) const
+{
+    static_assert( sizeof(CPoint) == sizeof(float) * 3, "CPoint must be packed x,y,z floats" );
+
+    NMatrixSimd::TransformPoints( &pDest->x, &pSource->x, count, matrix );
+
+}   // TransformBatch
+
+
+/************************************************************************
+*    desc:  Transform an array of quads in one call
+*
+*    param: CQuad * pDest - destination quads
+*           const CQuad * pSource - source quads
+*           int count - number of quads
+************************************************************************/
+void CMatrix::TransformBatch( CQuad * pDest, const CQuad * pSource, int count ) const
+{
+    static_assert( sizeof(CQuad) == sizeof(CPoint) * 4, "CQuad must be four packed points" );
+
+    TransformBatch( pDest->point, pSource->point, count * 4 );
+
+}   // TransformBatch
+
+
+/************************************************************************
+*    desc:  Transform structure of arrays point data in one call.
+*           Eight points go through per instruction on AVX2.
+*
+*    param: float * pDestX, pDestY, pDestZ - destination arrays
+*           const float * pSrcX, pSrcY, pSrcZ - source arrays
+*           int count - number of points
+************************************************************************/
+void CMatrix::TransformBatch(
+    float * pDestX, float * pDestY, float * pDestZ,
+    const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+    int count ) const
+{
+    NMatrixSimd::TransformPointsSoA( pDestX, pDestY, pDestZ, pSrcX, pSrcY, pSrcZ, count, matrix );
+
+}   // TransformBatch
+
+
 /************************************************************************
 *    desc:   Get matrix point in space
 *
@@ -631,6 +756,32 @@ bool CMatrix::Inverse()
 }	// Inverse
 
 
+/************************************************************************
+*    desc:  Full projective inverse of this matrix. Unlike Inverse, this
+*           makes no assumptions about the matrix.
+*
+*    ret: bool - true on success. The matrix is unchanged on failure
+************************************************************************/
+bool CMatrix::InverseFull()
+{
+    return NMatrixSimd::Inverse( matrix, matrix );
+
+}   // InverseFull
+
+
+/************************************************************************
+*    desc:  Fast inverse of an affine matrix. Assumes the last column is
+*           [0 0 0 1] but, unlike Inverse, handles scale and shear.
+*
+*    ret: bool - true on success. The matrix is unchanged on failure
+************************************************************************/
+bool CMatrix::InverseAffine()
+{
+    return NMatrixSimd::InverseAffine( matrix, matrix );
+
+}   // InverseAffine
+
+
 /************************************************************************
 *    desc:  Inverse the Z. 
 ************************************************************************/
@@ -749,8 +900,8 @@ void CMatrix::Multiply3x3( const CMatrix & obj )
 ************************************************************************/  
 void CMatrix::RotateZRad( float dest[mMax], float value, int rotFlags )
 {
-    float cosZ = cos(value);
-    float sinZ = sin(value);
+    float sinZ, cosZ;
+    NFastMath::SinCos( value, sinZ, cosZ );
 
     dest[0] = cosZ;
     dest[1] = sinZ;
@@ -769,8 +920,8 @@ void CMatrix::RotateZRad( float dest[mMax], float value, int rotFlags )
 ************************************************************************/  
 void CMatrix::RotateYRad( float dest[mMax], float value, int rotFlags )
 {
-    float cosY = cos(value);
-    float sinY = sin(value);
+    float sinY, cosY;
+    NFastMath::SinCos( value, sinY, cosY );
 
     switch( rotFlags )
     {
@@ -811,8 +962,8 @@ void CMatrix::RotateYRad( float dest[mMax], float value, int rotFlags )
 ************************************************************************/  
 void CMatrix::RotateXRad( float dest[mMax], float value, int rotFlags )
 {
-    float cosX = cos(value);
-    float sinX = sin(value);
+    float sinX, cosX;
+    NFastMath::SinCos( value, sinX, cosX );
 
     switch( rotFlags )
     {
@@ -890,16 +1041,8 @@ CMatrix CMatrix::operator * ( const CMatrix & obj ) const
 {
     float tmp2[mMax];
 
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        { 
-            tmp2[(i*4)+j] =   (matrix[i*4]	   * obj[j])
-                            + (matrix[(i*4)+1] * obj[4+j])
-                            + (matrix[(i*4)+2] * obj[8+j])
-                            + (matrix[(i*4)+3] * obj[12+j]);
-        }
-    }
+    // Use the raw array. The [] operator range checks every access
+    NMatrixSimd::Multiply( tmp2, matrix, obj.matrix );
 
     return CMatrix(tmp2);
 
@@ -915,21 +1058,7 @@ CMatrix CMatrix::operator * ( const CMatrix & obj ) const
 ************************************************************************/
 CMatrix CMatrix::operator *= ( const CMatrix & obj )
 {
-    float tmp2[mMax];
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        { 
-            tmp2[(i*4)+j] =   (matrix[i*4]	   * obj[j])
-                            + (matrix[(i*4)+1] * obj[4+j])
-                            + (matrix[(i*4)+2] * obj[8+j])
-                            + (matrix[(i*4)+3] * obj[12+j]);
-        }
-    }
-
-    // Copy the tmp matrix to the class's matrix
-    memcpy( matrix, tmp2, sizeof(tmp2) );
+    NMatrixSimd::Multiply( matrix, matrix, obj.matrix );
 
     return *this;
 
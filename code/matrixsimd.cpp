@@ -0,0 +1,700 @@
+/************************************************************************
+*    FILE NAME:       matrixsimd.cpp
+*
+*    DESCRIPTION:     SIMD 4x4 matrix kernels with runtime CPU dispatch
+************************************************************************/
+
+// Physical component dependency
+#include <common/matrixsimd.h>
+
+// Standard lib dependencies
+#include <math.h>
+#include <memory.h>
+
+#if defined(MATRIX_SIMD_X86)
+    #include <emmintrin.h>
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+// GCC and Clang need to be told which functions may use the wider
+// instruction sets. MSVC lets any function use the intrinsics.
+#if defined(MATRIX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define MATRIX_TARGET_SSE2 __attribute__((target("sse2")))
+    #define MATRIX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define MATRIX_TARGET_SSE2
+    #define MATRIX_TARGET_AVX2
+#endif
+
+namespace NMatrixSimd
+{
+    // Selected kernel
+    static EKernel currentKernel = EK_SCALAR;
+
+    // Has a kernel been selected
+    static bool kernelSelected = false;
+
+    /************************************************************************
+    *    desc:  First call of the multiply selects the kernel and then
+    *           forwards the call on. This allows static CMatrix objects
+    *           to be multiplied before main is hit.
+    ************************************************************************/
+    static void ResolveMultiply( float * pDest, const float * pA, const float * pB )
+    {
+        SelectKernel();
+
+        pMultiply( pDest, pA, pB );
+
+    }   // ResolveMultiply
+
+    static void ResolveTransformPoints( float * pDest, const float * pSrc, int count, const float * pMat )
+    {
+        SelectKernel();
+
+        pTransformPoints( pDest, pSrc, count, pMat );
+
+    }   // ResolveTransformPoints
+
+    static void ResolveTransformPointsSoA(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat )
+    {
+        SelectKernel();
+
+        pTransformPointsSoA( pDestX, pDestY, pDestZ, pSrcX, pSrcY, pSrcZ, count, pMat );
+
+    }   // ResolveTransformPointsSoA
+
+    static bool ResolveInverse( float * pDest, const float * pSrc )
+    {
+        SelectKernel();
+
+        return pInverse( pDest, pSrc );
+
+    }   // ResolveInverse
+
+    MultiplyFunc pMultiply = ResolveMultiply;
+    TransformFunc pTransformPoints = ResolveTransformPoints;
+    TransformSoAFunc pTransformPointsSoA = ResolveTransformPointsSoA;
+    InverseFunc pInverse = ResolveInverse;
+
+    // Determinants smaller than this are treated as singular
+    static const float DET_EPSILON = 1E-12f;
+
+
+    /************************************************************************
+    *    desc:  Check the running CPU for SSE2 support
+    ************************************************************************/
+    static bool CpuHasSSE2()
+    {
+        #if defined(__x86_64__) || defined(_M_X64)
+        // Part of the x64 base instruction set
+        return true;
+        #elif defined(MATRIX_SIMD_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid( info, 1 );
+        return ((info[3] & (1 << 26)) != 0);
+        #elif defined(MATRIX_SIMD_X86)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports( "sse2" );
+        #else
+        return false;
+        #endif
+
+    }   // CpuHasSSE2
+
+
+    /************************************************************************
+    *    desc:  Check the running CPU and OS for AVX2 support
+    ************************************************************************/
+    static bool CpuHasAVX2()
+    {
+        #if defined(MATRIX_SIMD_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid( info, 0 );
+        if( info[0] < 7 )
+            return false;
+
+        // The OS has to save the YMM registers for AVX to be usable
+        __cpuid( info, 1 );
+        const bool osxsave( (info[2] & (1 << 27)) != 0 );
+        const bool avx( (info[2] & (1 << 28)) != 0 );
+        if( !osxsave || !avx || ((_xgetbv(0) & 6) != 6) )
+            return false;
+
+        __cpuidex( info, 7, 0 );
+        return ((info[1] & (1 << 5)) != 0);
+        #elif defined(MATRIX_SIMD_X86)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports( "avx2" );
+        #else
+        return false;
+        #endif
+
+    }   // CpuHasAVX2
+
+
+    /************************************************************************
+    *    desc:  Is this kernel supported on the running CPU
+    ************************************************************************/
+    bool IsSupported( EKernel kernel )
+    {
+        if( kernel == EK_SSE2 )
+            return CpuHasSSE2();
+
+        else if( kernel == EK_AVX2 )
+            return CpuHasAVX2();
+
+        return (kernel == EK_SCALAR);
+
+    }   // IsSupported
+
+
+    /************************************************************************
+    *    desc:  Pick the fastest kernel the running CPU supports
+    ************************************************************************/
+    EKernel SelectKernel()
+    {
+        if( IsSupported( EK_AVX2 ) )
+            SetKernel( EK_AVX2 );
+
+        else if( IsSupported( EK_SSE2 ) )
+            SetKernel( EK_SSE2 );
+
+        else
+            SetKernel( EK_SCALAR );
+
+        return currentKernel;
+
+    }   // SelectKernel
+
+
+    /************************************************************************
+    *    desc:  Force a kernel. Returns false if the CPU doesn't support it
+    ************************************************************************/
+    bool SetKernel( EKernel kernel )
+    {
+        if( !IsSupported( kernel ) )
+            return false;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( kernel == EK_AVX2 )
+        {
+            // Packed x,y,z points don't gain anything from the wider
+            // registers over the SSE2 deinterleave
+            pMultiply = MultiplyAVX2;
+            pTransformPoints = TransformPointsSSE2;
+            pTransformPointsSoA = TransformPointsSoAAVX2;
+            pInverse = InverseSSE2;
+        }
+        else if( kernel == EK_SSE2 )
+        {
+            pMultiply = MultiplySSE2;
+            pTransformPoints = TransformPointsSSE2;
+            pTransformPointsSoA = TransformPointsSoASSE2;
+            pInverse = InverseSSE2;
+        }
+        else
+        #endif
+        {
+            pMultiply = MultiplyScalar;
+            pTransformPoints = TransformPointsScalar;
+            pTransformPointsSoA = TransformPointsSoAScalar;
+            pInverse = InverseScalar;
+        }
+
+        currentKernel = kernel;
+        kernelSelected = true;
+
+        return true;
+
+    }   // SetKernel
+
+
+    /************************************************************************
+    *    desc:  Get the selected kernel
+    ************************************************************************/
+    EKernel GetKernel()
+    {
+        if( !kernelSelected )
+            SelectKernel();
+
+        return currentKernel;
+
+    }   // GetKernel
+
+
+    /************************************************************************
+    *    desc:  Get the name of the kernel
+    ************************************************************************/
+    const char * GetKernelName( EKernel kernel )
+    {
+        if( kernel == EK_AVX2 )
+            return "avx2";
+
+        else if( kernel == EK_SSE2 )
+            return "sse2";
+
+        return "scalar";
+
+    }   // GetKernelName
+
+
+    /************************************************************************
+    *    desc:  Scalar multiply. This is the original CMatrix triple loop
+    ************************************************************************/
+    void MultiplyScalar( float * pDest, const float * pA, const float * pB )
+    {
+        float temp[16];
+
+        for( int i = 0; i < 4; ++i )
+        {
+            for( int j = 0; j < 4; ++j )
+            {
+                temp[(i*4)+j] = (pA[i*4]     * pB[j])
+                              + (pA[(i*4)+1] * pB[4+j])
+                              + (pA[(i*4)+2] * pB[8+j])
+                              + (pA[(i*4)+3] * pB[12+j]);
+            }
+        }
+
+        // Copy temp to the destination
+        memcpy( pDest, temp, sizeof(temp) );
+
+    }   // MultiplyScalar
+
+
+    /************************************************************************
+    *    desc:  Scalar transform of packed x,y,z points
+    ************************************************************************/
+    void TransformPointsScalar( float * pDest, const float * pSrc, int count, const float * pMat )
+    {
+        for( int i = 0; i < count * 3; i += 3 )
+        {
+            const float x = pSrc[i];
+            const float y = pSrc[i+1];
+            const float z = pSrc[i+2];
+
+            pDest[i]   = (x * pMat[0]) + (y * pMat[4]) + (z * pMat[8])  + pMat[12];
+            pDest[i+1] = (x * pMat[1]) + (y * pMat[5]) + (z * pMat[9])  + pMat[13];
+            pDest[i+2] = (x * pMat[2]) + (y * pMat[6]) + (z * pMat[10]) + pMat[14];
+        }
+
+    }   // TransformPointsScalar
+
+
+    /************************************************************************
+    *    desc:  Scalar transform of separate x, y and z arrays
+    ************************************************************************/
+    void TransformPointsSoAScalar(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat )
+    {
+        for( int i = 0; i < count; ++i )
+        {
+            const float x = pSrcX[i];
+            const float y = pSrcY[i];
+            const float z = pSrcZ[i];
+
+            pDestX[i] = (x * pMat[0]) + (y * pMat[4]) + (z * pMat[8])  + pMat[12];
+            pDestY[i] = (x * pMat[1]) + (y * pMat[5]) + (z * pMat[9])  + pMat[13];
+            pDestZ[i] = (x * pMat[2]) + (y * pMat[6]) + (z * pMat[10]) + pMat[14];
+        }
+
+    }   // TransformPointsSoAScalar
+
+
+    /************************************************************************
+    *    desc:  Scalar general 4x4 inverse by cofactor expansion. The
+    *           inverse of the transpose is the transpose of the inverse
+    *           so this works on either storage order.
+    ************************************************************************/
+    bool InverseScalar( float * pDest, const float * m )
+    {
+        float inv[16];
+
+        inv[0]  =  m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
+        inv[4]  = -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
+        inv[8]  =  m[4]*m[9]*m[15]  - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
+        inv[12] = -m[4]*m[9]*m[14]  + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
+
+        inv[1]  = -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
+        inv[5]  =  m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
+        inv[9]  = -m[0]*m[9]*m[15]  + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
+        inv[13] =  m[0]*m[9]*m[14]  - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
+
+        inv[2]  =  m[1]*m[6]*m[15]  - m[1]*m[7]*m[14]  - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7]  - m[13]*m[3]*m[6];
+        inv[6]  = -m[0]*m[6]*m[15]  + m[0]*m[7]*m[14]  + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7]  + m[12]*m[3]*m[6];
+        inv[10] =  m[0]*m[5]*m[15]  - m[0]*m[7]*m[13]  - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7]  - m[12]*m[3]*m[5];
+        inv[14] = -m[0]*m[5]*m[14]  + m[0]*m[6]*m[13]  + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6]  + m[12]*m[2]*m[5];
+
+        inv[3]  = -m[1]*m[6]*m[11]  + m[1]*m[7]*m[10]  + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7]   + m[9]*m[3]*m[6];
+        inv[7]  =  m[0]*m[6]*m[11]  - m[0]*m[7]*m[10]  - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7]   - m[8]*m[3]*m[6];
+        inv[11] = -m[0]*m[5]*m[11]  + m[0]*m[7]*m[9]   + m[4]*m[1]*m[11] - m[4]*m[3]*m[9]  - m[8]*m[1]*m[7]   + m[8]*m[3]*m[5];
+        inv[15] =  m[0]*m[5]*m[10]  - m[0]*m[6]*m[9]   - m[4]*m[1]*m[10] + m[4]*m[2]*m[9]  + m[8]*m[1]*m[6]   - m[8]*m[2]*m[5];
+
+        const float det = (m[0] * inv[0]) + (m[1] * inv[4]) + (m[2] * inv[8]) + (m[3] * inv[12]);
+
+        if( fabs(det) < DET_EPSILON )
+            return false;
+
+        const float detInv = 1.0f / det;
+
+        for( int i = 0; i < 16; ++i )
+            pDest[i] = inv[i] * detInv;
+
+        return true;
+
+    }   // InverseScalar
+
+
+    /************************************************************************
+    *    desc:  Inverse of an affine matrix. The 3x3 part is inverted by
+    *           cofactors and the translation is run through it. Handles
+    *           scale, unlike CMatrix::Inverse which assumes the rotation
+    *           is orthonormal.
+    ************************************************************************/
+    bool InverseAffine( float * pDest, const float * m )
+    {
+        const float c00 = (m[5] * m[10]) - (m[6] * m[9]);
+        const float c01 = (m[6] * m[8])  - (m[4] * m[10]);
+        const float c02 = (m[4] * m[9])  - (m[5] * m[8]);
+
+        const float det = (m[0] * c00) + (m[1] * c01) + (m[2] * c02);
+
+        if( fabs(det) < DET_EPSILON )
+            return false;
+
+        const float detInv = 1.0f / det;
+
+        float inv[16];
+
+        inv[0]  = c00 * detInv;
+        inv[1]  = ((m[2] * m[9])  - (m[1] * m[10])) * detInv;
+        inv[2]  = ((m[1] * m[6])  - (m[2] * m[5]))  * detInv;
+        inv[3]  = 0.0f;
+
+        inv[4]  = c01 * detInv;
+        inv[5]  = ((m[0] * m[10]) - (m[2] * m[8]))  * detInv;
+        inv[6]  = ((m[2] * m[4])  - (m[0] * m[6]))  * detInv;
+        inv[7]  = 0.0f;
+
+        inv[8]  = c02 * detInv;
+        inv[9]  = ((m[1] * m[8])  - (m[0] * m[9]))  * detInv;
+        inv[10] = ((m[0] * m[5])  - (m[1] * m[4]))  * detInv;
+        inv[11] = 0.0f;
+
+        // Translation is -t * inverse(3x3)
+        inv[12] = -((m[12] * inv[0]) + (m[13] * inv[4]) + (m[14] * inv[8]));
+        inv[13] = -((m[12] * inv[1]) + (m[13] * inv[5]) + (m[14] * inv[9]));
+        inv[14] = -((m[12] * inv[2]) + (m[13] * inv[6]) + (m[14] * inv[10]));
+        inv[15] = 1.0f;
+
+        memcpy( pDest, inv, sizeof(inv) );
+
+        return true;
+
+    }   // InverseAffine
+
+
+    #if defined(MATRIX_SIMD_X86)
+
+    /************************************************************************
+    *    desc:  SSE2 multiply. Each row of the result is the rows of b
+    *           scaled by the matching elements of that row of a.
+    *
+    *    NOTE:  All of b is loaded up front and each row of a is loaded
+    *           before that row is stored so pDest can alias a or b.
+    ************************************************************************/
+    MATRIX_TARGET_SSE2
+    void MultiplySSE2( float * pDest, const float * pA, const float * pB )
+    {
+        const __m128 b0 = _mm_loadu_ps( pB );
+        const __m128 b1 = _mm_loadu_ps( pB + 4 );
+        const __m128 b2 = _mm_loadu_ps( pB + 8 );
+        const __m128 b3 = _mm_loadu_ps( pB + 12 );
+
+        for( int i = 0; i < 16; i += 4 )
+        {
+            const __m128 a = _mm_loadu_ps( pA + i );
+
+            __m128 row = _mm_mul_ps( _mm_shuffle_ps( a, a, 0x00 ), b0 );
+            row = _mm_add_ps( row, _mm_mul_ps( _mm_shuffle_ps( a, a, 0x55 ), b1 ) );
+            row = _mm_add_ps( row, _mm_mul_ps( _mm_shuffle_ps( a, a, 0xAA ), b2 ) );
+            row = _mm_add_ps( row, _mm_mul_ps( _mm_shuffle_ps( a, a, 0xFF ), b3 ) );
+
+            _mm_storeu_ps( pDest + i, row );
+        }
+
+    }   // MultiplySSE2
+
+
+    /************************************************************************
+    *    desc:  AVX2 multiply. Two rows of the result are done per pass
+    *           with the rows of b broadcast to both 128 bit lanes.
+    *
+    *    NOTE:  Separate multiply and add are used instead of FMA so the
+    *           results match the SSE2 kernel bit for bit.
+    ************************************************************************/
+    MATRIX_TARGET_AVX2
+    void MultiplyAVX2( float * pDest, const float * pA, const float * pB )
+    {
+        const __m256 b0 = _mm256_broadcast_ps( (const __m128 *)(pB) );
+        const __m256 b1 = _mm256_broadcast_ps( (const __m128 *)(pB + 4) );
+        const __m256 b2 = _mm256_broadcast_ps( (const __m128 *)(pB + 8) );
+        const __m256 b3 = _mm256_broadcast_ps( (const __m128 *)(pB + 12) );
+
+        const __m256 a01 = _mm256_loadu_ps( pA );
+        const __m256 a23 = _mm256_loadu_ps( pA + 8 );
+
+        __m256 r01 = _mm256_mul_ps( _mm256_permute_ps( a01, 0x00 ), b0 );
+        r01 = _mm256_add_ps( r01, _mm256_mul_ps( _mm256_permute_ps( a01, 0x55 ), b1 ) );
+        r01 = _mm256_add_ps( r01, _mm256_mul_ps( _mm256_permute_ps( a01, 0xAA ), b2 ) );
+        r01 = _mm256_add_ps( r01, _mm256_mul_ps( _mm256_permute_ps( a01, 0xFF ), b3 ) );
+
+        __m256 r23 = _mm256_mul_ps( _mm256_permute_ps( a23, 0x00 ), b0 );
+        r23 = _mm256_add_ps( r23, _mm256_mul_ps( _mm256_permute_ps( a23, 0x55 ), b1 ) );
+        r23 = _mm256_add_ps( r23, _mm256_mul_ps( _mm256_permute_ps( a23, 0xAA ), b2 ) );
+        r23 = _mm256_add_ps( r23, _mm256_mul_ps( _mm256_permute_ps( a23, 0xFF ), b3 ) );
+
+        _mm256_storeu_ps( pDest, r01 );
+        _mm256_storeu_ps( pDest + 8, r23 );
+
+    }   // MultiplyAVX2
+
+
+    /************************************************************************
+    *    desc:  SSE2 general 4x4 inverse using the 2x2 block method.
+    *           The matrix is split into A B / C D sub matrices and the
+    *           inverse built from their adjugates and determinants.
+    ************************************************************************/
+    #define SHUFFLE_MASK(x,y,z,w)  ((x) | ((y)<<2) | ((z)<<4) | ((w)<<6))
+    #define SWIZZLE(v,x,y,z,w)     _mm_shuffle_ps( v, v, SHUFFLE_MASK(x,y,z,w) )
+    #define SHUFFLE(a,b,x,y,z,w)   _mm_shuffle_ps( a, b, SHUFFLE_MASK(x,y,z,w) )
+
+    // 2x2 row major matrix multiply A * B
+    MATRIX_TARGET_SSE2
+    static inline __m128 Mat2Mul( __m128 a, __m128 b )
+    {
+        return _mm_add_ps( _mm_mul_ps( a, SWIZZLE(b, 0,3,0,3) ),
+                           _mm_mul_ps( SWIZZLE(a, 1,0,3,2), SWIZZLE(b, 2,1,2,1) ) );
+    }
+
+    // 2x2 row major adjugate multiply (A#) * B
+    MATRIX_TARGET_SSE2
+    static inline __m128 Mat2AdjMul( __m128 a, __m128 b )
+    {
+        return _mm_sub_ps( _mm_mul_ps( SWIZZLE(a, 3,3,0,0), b ),
+                           _mm_mul_ps( SWIZZLE(a, 1,1,2,2), SWIZZLE(b, 2,3,0,1) ) );
+    }
+
+    // 2x2 row major multiply adjugate A * (B#)
+    MATRIX_TARGET_SSE2
+    static inline __m128 Mat2MulAdj( __m128 a, __m128 b )
+    {
+        return _mm_sub_ps( _mm_mul_ps( a, SWIZZLE(b, 3,0,3,0) ),
+                           _mm_mul_ps( SWIZZLE(a, 1,0,3,2), SWIZZLE(b, 2,1,2,1) ) );
+    }
+
+    MATRIX_TARGET_SSE2
+    bool InverseSSE2( float * pDest, const float * pSrc )
+    {
+        const __m128 r0 = _mm_loadu_ps( pSrc );
+        const __m128 r1 = _mm_loadu_ps( pSrc + 4 );
+        const __m128 r2 = _mm_loadu_ps( pSrc + 8 );
+        const __m128 r3 = _mm_loadu_ps( pSrc + 12 );
+
+        // Sub matrices
+        const __m128 A = _mm_movelh_ps( r0, r1 );
+        const __m128 B = _mm_movehl_ps( r1, r0 );
+        const __m128 C = _mm_movelh_ps( r2, r3 );
+        const __m128 D = _mm_movehl_ps( r3, r2 );
+
+        // Determinants of the sub matrices as |A| |B| |C| |D|
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps( SHUFFLE(r0, r2, 0,2,0,2), SHUFFLE(r1, r3, 1,3,1,3) ),
+            _mm_mul_ps( SHUFFLE(r0, r2, 1,3,1,3), SHUFFLE(r1, r3, 0,2,0,2) ) );
+
+        const __m128 detA = SWIZZLE(detSub, 0,0,0,0);
+        const __m128 detB = SWIZZLE(detSub, 1,1,1,1);
+        const __m128 detC = SWIZZLE(detSub, 2,2,2,2);
+        const __m128 detD = SWIZZLE(detSub, 3,3,3,3);
+
+        const __m128 D_C = Mat2AdjMul( D, C );
+        const __m128 A_B = Mat2AdjMul( A, B );
+
+        __m128 X_ = _mm_sub_ps( _mm_mul_ps( detD, A ), Mat2Mul( B, D_C ) );
+        __m128 W_ = _mm_sub_ps( _mm_mul_ps( detA, D ), Mat2Mul( C, A_B ) );
+        __m128 Y_ = _mm_sub_ps( _mm_mul_ps( detB, C ), Mat2MulAdj( D, A_B ) );
+        __m128 Z_ = _mm_sub_ps( _mm_mul_ps( detC, B ), Mat2MulAdj( A, D_C ) );
+
+        // |M| = |A|*|D| + |B|*|C| - tr((A#B)(D#C))
+        __m128 tr = _mm_mul_ps( A_B, SWIZZLE(D_C, 0,2,1,3) );
+        tr = _mm_add_ps( tr, SWIZZLE(tr, 2,3,0,1) );
+        tr = _mm_add_ps( tr, SWIZZLE(tr, 1,0,3,2) );
+
+        const __m128 detM = _mm_sub_ps( _mm_add_ps( _mm_mul_ps( detA, detD ), _mm_mul_ps( detB, detC ) ), tr );
+
+        if( fabs( _mm_cvtss_f32( detM ) ) < DET_EPSILON )
+            return false;
+
+        // (1/|M|, -1/|M|, -1/|M|, 1/|M|)
+        const __m128 rDetM = _mm_div_ps( _mm_setr_ps( 1.f, -1.f, -1.f, 1.f ), detM );
+
+        X_ = _mm_mul_ps( X_, rDetM );
+        Y_ = _mm_mul_ps( Y_, rDetM );
+        Z_ = _mm_mul_ps( Z_, rDetM );
+        W_ = _mm_mul_ps( W_, rDetM );
+
+        // Apply the adjugate shuffle while storing
+        _mm_storeu_ps( pDest,      SHUFFLE(X_, Y_, 3,1,3,1) );
+        _mm_storeu_ps( pDest + 4,  SHUFFLE(X_, Y_, 2,0,2,0) );
+        _mm_storeu_ps( pDest + 8,  SHUFFLE(Z_, W_, 3,1,3,1) );
+        _mm_storeu_ps( pDest + 12, SHUFFLE(Z_, W_, 2,0,2,0) );
+
+        return true;
+
+    }   // InverseSSE2
+
+    #undef SHUFFLE_MASK
+    #undef SWIZZLE
+    #undef SHUFFLE
+
+
+    /************************************************************************
+    *    desc:  SSE2 transform of packed x,y,z points. Four points (three
+    *           registers) are deinterleaved into x, y and z registers,
+    *           transformed and interleaved back. Any remainder is scalar.
+    ************************************************************************/
+    MATRIX_TARGET_SSE2
+    void TransformPointsSSE2( float * pDest, const float * pSrc, int count, const float * pMat )
+    {
+        const __m128 m0 = _mm_set1_ps( pMat[0] ),  m1 = _mm_set1_ps( pMat[1] ),  m2 = _mm_set1_ps( pMat[2] );
+        const __m128 m4 = _mm_set1_ps( pMat[4] ),  m5 = _mm_set1_ps( pMat[5] ),  m6 = _mm_set1_ps( pMat[6] );
+        const __m128 m8 = _mm_set1_ps( pMat[8] ),  m9 = _mm_set1_ps( pMat[9] ),  m10 = _mm_set1_ps( pMat[10] );
+        const __m128 m12 = _mm_set1_ps( pMat[12] ), m13 = _mm_set1_ps( pMat[13] ), m14 = _mm_set1_ps( pMat[14] );
+
+        const int blockCount = count & ~3;
+
+        for( int i = 0; i < blockCount * 3; i += 12 )
+        {
+            // v0 = x0 y0 z0 x1, v1 = y1 z1 x2 y2, v2 = z2 x3 y3 z3
+            const __m128 v0 = _mm_loadu_ps( pSrc + i );
+            const __m128 v1 = _mm_loadu_ps( pSrc + i + 4 );
+            const __m128 v2 = _mm_loadu_ps( pSrc + i + 8 );
+
+            const __m128 x2x3 = _mm_shuffle_ps( v1, v2, _MM_SHUFFLE(1,1,2,2) );
+            const __m128 x = _mm_shuffle_ps( v0, x2x3, _MM_SHUFFLE(2,0,3,0) );
+
+            const __m128 y0y1 = _mm_shuffle_ps( v0, v1, _MM_SHUFFLE(0,0,1,1) );
+            const __m128 y2y3 = _mm_shuffle_ps( v1, v2, _MM_SHUFFLE(2,2,3,3) );
+            const __m128 y = _mm_shuffle_ps( y0y1, y2y3, _MM_SHUFFLE(2,0,2,0) );
+
+            const __m128 z0z1 = _mm_shuffle_ps( v0, v1, _MM_SHUFFLE(1,1,2,2) );
+            const __m128 z = _mm_shuffle_ps( z0z1, v2, _MM_SHUFFLE(3,0,2,0) );
+
+            const __m128 tx = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m0 ), _mm_mul_ps( y, m4 ) ), _mm_add_ps( _mm_mul_ps( z, m8 ), m12 ) );
+            const __m128 ty = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m1 ), _mm_mul_ps( y, m5 ) ), _mm_add_ps( _mm_mul_ps( z, m9 ), m13 ) );
+            const __m128 tz = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m2 ), _mm_mul_ps( y, m6 ) ), _mm_add_ps( _mm_mul_ps( z, m10 ), m14 ) );
+
+            // Interleave back to x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3
+            const __m128 x0y0 = _mm_shuffle_ps( tx, ty, _MM_SHUFFLE(0,0,0,0) );
+            const __m128 z0x1 = _mm_shuffle_ps( tz, tx, _MM_SHUFFLE(1,1,0,0) );
+            _mm_storeu_ps( pDest + i, _mm_shuffle_ps( x0y0, z0x1, _MM_SHUFFLE(2,0,2,0) ) );
+
+            const __m128 y1z1 = _mm_shuffle_ps( ty, tz, _MM_SHUFFLE(1,1,1,1) );
+            const __m128 x2y2 = _mm_shuffle_ps( tx, ty, _MM_SHUFFLE(2,2,2,2) );
+            _mm_storeu_ps( pDest + i + 4, _mm_shuffle_ps( y1z1, x2y2, _MM_SHUFFLE(2,0,2,0) ) );
+
+            const __m128 z2x3 = _mm_shuffle_ps( tz, tx, _MM_SHUFFLE(3,3,2,2) );
+            const __m128 y3z3 = _mm_shuffle_ps( ty, tz, _MM_SHUFFLE(3,3,3,3) );
+            _mm_storeu_ps( pDest + i + 8, _mm_shuffle_ps( z2x3, y3z3, _MM_SHUFFLE(2,0,2,0) ) );
+        }
+
+        // Finish off what doesn't fit in a block of four
+        if( blockCount < count )
+            TransformPointsScalar( pDest + (blockCount * 3), pSrc + (blockCount * 3), count - blockCount, pMat );
+
+    }   // TransformPointsSSE2
+
+
+    /************************************************************************
+    *    desc:  SSE2 transform of separate x, y and z arrays. Four points
+    *           per instruction.
+    ************************************************************************/
+    MATRIX_TARGET_SSE2
+    void TransformPointsSoASSE2(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat )
+    {
+        const __m128 m0 = _mm_set1_ps( pMat[0] ),  m1 = _mm_set1_ps( pMat[1] ),  m2 = _mm_set1_ps( pMat[2] );
+        const __m128 m4 = _mm_set1_ps( pMat[4] ),  m5 = _mm_set1_ps( pMat[5] ),  m6 = _mm_set1_ps( pMat[6] );
+        const __m128 m8 = _mm_set1_ps( pMat[8] ),  m9 = _mm_set1_ps( pMat[9] ),  m10 = _mm_set1_ps( pMat[10] );
+        const __m128 m12 = _mm_set1_ps( pMat[12] ), m13 = _mm_set1_ps( pMat[13] ), m14 = _mm_set1_ps( pMat[14] );
+
+        const int blockCount = count & ~3;
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const __m128 x = _mm_loadu_ps( pSrcX + i );
+            const __m128 y = _mm_loadu_ps( pSrcY + i );
+            const __m128 z = _mm_loadu_ps( pSrcZ + i );
+
+            _mm_storeu_ps( pDestX + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m0 ), _mm_mul_ps( y, m4 ) ), _mm_add_ps( _mm_mul_ps( z, m8 ), m12 ) ) );
+            _mm_storeu_ps( pDestY + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m1 ), _mm_mul_ps( y, m5 ) ), _mm_add_ps( _mm_mul_ps( z, m9 ), m13 ) ) );
+            _mm_storeu_ps( pDestZ + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m2 ), _mm_mul_ps( y, m6 ) ), _mm_add_ps( _mm_mul_ps( z, m10 ), m14 ) ) );
+        }
+
+        if( blockCount < count )
+            TransformPointsSoAScalar(
+                pDestX + blockCount, pDestY + blockCount, pDestZ + blockCount,
+                pSrcX + blockCount, pSrcY + blockCount, pSrcZ + blockCount,
+                count - blockCount, pMat );
+
+    }   // TransformPointsSoASSE2
+
+
+    /************************************************************************
+    *    desc:  AVX2 transform of separate x, y and z arrays. Eight points
+    *           per instruction.
+    ************************************************************************/
+    MATRIX_TARGET_AVX2
+    void TransformPointsSoAAVX2(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat )
+    {
+        const __m256 m0 = _mm256_set1_ps( pMat[0] ),  m1 = _mm256_set1_ps( pMat[1] ),  m2 = _mm256_set1_ps( pMat[2] );
+        const __m256 m4 = _mm256_set1_ps( pMat[4] ),  m5 = _mm256_set1_ps( pMat[5] ),  m6 = _mm256_set1_ps( pMat[6] );
+        const __m256 m8 = _mm256_set1_ps( pMat[8] ),  m9 = _mm256_set1_ps( pMat[9] ),  m10 = _mm256_set1_ps( pMat[10] );
+        const __m256 m12 = _mm256_set1_ps( pMat[12] ), m13 = _mm256_set1_ps( pMat[13] ), m14 = _mm256_set1_ps( pMat[14] );
+
+        const int blockCount = count & ~7;
+
+        for( int i = 0; i < blockCount; i += 8 )
+        {
+            const __m256 x = _mm256_loadu_ps( pSrcX + i );
+            const __m256 y = _mm256_loadu_ps( pSrcY + i );
+            const __m256 z = _mm256_loadu_ps( pSrcZ + i );
+
+            _mm256_storeu_ps( pDestX + i, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( x, m0 ), _mm256_mul_ps( y, m4 ) ), _mm256_add_ps( _mm256_mul_ps( z, m8 ), m12 ) ) );
+            _mm256_storeu_ps( pDestY + i, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( x, m1 ), _mm256_mul_ps( y, m5 ) ), _mm256_add_ps( _mm256_mul_ps( z, m9 ), m13 ) ) );
+            _mm256_storeu_ps( pDestZ + i, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( x, m2 ), _mm256_mul_ps( y, m6 ) ), _mm256_add_ps( _mm256_mul_ps( z, m10 ), m14 ) ) );
+        }
+
+        if( blockCount < count )
+            TransformPointsSoAScalar(
+                pDestX + blockCount, pDestY + blockCount, pDestZ + blockCount,
+                pSrcX + blockCount, pSrcY + blockCount, pSrcZ + blockCount,
+                count - blockCount, pMat );
+
+    }   // TransformPointsSoAAVX2
+
+    #endif  // MATRIX_SIMD_X86
+}
@@ -0,0 +1,121 @@
+/************************************************************************
+*    FILE NAME:       matrixsimd.h
+*
+*    DESCRIPTION:     SIMD 4x4 matrix kernels with runtime CPU dispatch
+************************************************************************/
+
+#ifndef __matrix_simd_h__
+#define __matrix_simd_h__
+
+// Define MATRIX_ALIGNED_STORAGE to have CMatrix keep its float array on
+// a 32 byte boundary. The kernels use unaligned loads when it's not set.
+#if defined(MATRIX_ALIGNED_STORAGE)
+    #if defined(_MSC_VER)
+        #define MATRIX_ALIGN __declspec(align(32))
+    #else
+        #define MATRIX_ALIGN alignas(32)
+    #endif
+#else
+    #define MATRIX_ALIGN
+#endif
+
+// Only x86 builds get the SSE2/AVX2 kernels. Everything else is scalar.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define MATRIX_SIMD_X86
+#endif
+
+namespace NMatrixSimd
+{
+    enum EKernel
+    {
+        EK_SCALAR,
+        EK_SSE2,
+        EK_AVX2,
+    };
+
+    // Kernel function signature. dest = a * b in the row vector convention
+    // used by CMatrix. dest is allowed to alias a or b.
+    typedef void (*MultiplyFunc)( float * pDest, const float * pA, const float * pB );
+
+    // Point transform signatures. Points are transformed by the full
+    // affine part of the matrix the same as CMatrix::Transform.
+    // AoS is packed x,y,z triples. SoA is separate x, y and z arrays.
+    // The destination is allowed to be the same memory as the source.
+    typedef void (*TransformFunc)( float * pDest, const float * pSrc, int count, const float * pMat );
+    typedef void (*TransformSoAFunc)(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat );
+
+    // General 4x4 inverse signature. Returns false if the matrix is
+    // singular in which case pDest is left untouched. pDest can be pSrc.
+    typedef bool (*InverseFunc)( float * pDest, const float * pSrc );
+
+    // Currently selected kernels. Resolved on first use.
+    extern MultiplyFunc pMultiply;
+    extern TransformFunc pTransformPoints;
+    extern TransformSoAFunc pTransformPointsSoA;
+    extern InverseFunc pInverse;
+
+    // Multiply two 4x4 matrices with the selected kernel
+    inline void Multiply( float * pDest, const float * pA, const float * pB )
+    { pMultiply( pDest, pA, pB ); }
+
+    // Transform an array of packed x,y,z points with the selected kernel
+    inline void TransformPoints( float * pDest, const float * pSrc, int count, const float * pMat )
+    { pTransformPoints( pDest, pSrc, count, pMat ); }
+
+    // Transform separate x, y and z arrays with the selected kernel
+    inline void TransformPointsSoA(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat )
+    { pTransformPointsSoA( pDestX, pDestY, pDestZ, pSrcX, pSrcY, pSrcZ, count, pMat ); }
+
+    // Full projective inverse with the selected kernel
+    inline bool Inverse( float * pDest, const float * pSrc )
+    { return pInverse( pDest, pSrc ); }
+
+    // Inverse of an affine matrix (last column is [0 0 0 1])
+    bool InverseAffine( float * pDest, const float * pSrc );
+
+    // Pick the fastest kernel the running CPU supports
+    EKernel SelectKernel();
+
+    // Force a kernel. Returns false if the CPU doesn't support it
+    bool SetKernel( EKernel kernel );
+
+    // Get the selected kernel
+    EKernel GetKernel();
+
+    // Get the name of the kernel for logging and benchmarks
+    const char * GetKernelName( EKernel kernel );
+
+    // Is this kernel supported on the running CPU
+    bool IsSupported( EKernel kernel );
+
+    // The individual kernels
+    void MultiplyScalar( float * pDest, const float * pA, const float * pB );
+    void TransformPointsScalar( float * pDest, const float * pSrc, int count, const float * pMat );
+    void TransformPointsSoAScalar(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat );
+    bool InverseScalar( float * pDest, const float * pSrc );
+    #if defined(MATRIX_SIMD_X86)
+    void MultiplySSE2( float * pDest, const float * pA, const float * pB );
+    void MultiplyAVX2( float * pDest, const float * pA, const float * pB );
+    void TransformPointsSSE2( float * pDest, const float * pSrc, int count, const float * pMat );
+    void TransformPointsSoASSE2(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat );
+    void TransformPointsSoAAVX2(
+        float * pDestX, float * pDestY, float * pDestZ,
+        const float * pSrcX, const float * pSrcY, const float * pSrcZ,
+        int count, const float * pMat );
+    bool InverseSSE2( float * pDest, const float * pSrc );
+    #endif
+}
+
+#endif  // __matrix_simd_h__
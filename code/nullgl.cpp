@@ -0,0 +1,768 @@
+/************************************************************************
+*    FILE NAME:       nullgl.cpp
+*
+*    DESCRIPTION:     Null GL backend for headless builds. Counts and
+*                     records the GL calls without rendering.
+************************************************************************/
+
+#if defined(NULL_GL_BACKEND)
+
+// Physical component dependency
+#include <system/nullgl.h>
+
+// Standard lib dependencies
+#include <cstring>
+#include <sstream>
+#include <fstream>
+#include <memory>
+#include <map>
+
+namespace
+{
+    void AddArgs( std::ostream & )
+    {
+    }
+
+    template<typename T, typename... TArgs>
+    void AddArgs( std::ostream & rStream, const T & arg, const TArgs &... args )
+    {
+        rStream << arg;
+
+        if( sizeof...(args) > 0 )
+            rStream << ", ";
+
+        AddArgs( rStream, args... );
+    }
+
+    // Format the args of a call. Only done when recording.
+    template<typename... TArgs>
+    std::string Args( const TArgs &... args )
+    {
+        if( !CNullGL::Instance().IsRecording() )
+            return std::string();
+
+        std::ostringstream stream;
+        AddArgs( stream, args... );
+
+        return stream.str();
+    }
+
+    // Buffer bound to each target. Only used to know which buffer is mapped.
+    std::map<GLenum, GLuint> boundBufferMap;
+
+    // Memory handed out for mapped buffers by buffer. Freed when the
+    // buffer is unmapped or deleted.
+    std::map<GLuint, std::unique_ptr<unsigned char[]>> mappedMemMap;
+
+    // Bytes of a pixel of a texture upload
+    size_t GetBytesPerPixel( GLenum format )
+    {
+        switch( format )
+        {
+            case GL_RED:
+            case GL_ALPHA:
+                return 1;
+            case GL_RG:
+                return 2;
+            case GL_RGB:
+                return 3;
+            default:
+                return 4;
+        }
+    }
+}
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CNullGL::CNullGL() :
+    m_recording(false),
+    m_featuresAvailable(true),
+    m_nextName(1),
+    m_frameStart( std::chrono::high_resolution_clock::now() )
+{
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CNullGL::~CNullGL()
+{
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Count a call
+*
+*    param: const char * pName - GL function name. Has to be a literal.
+*           ECallType type - kind of call for the stats
+*           size_t bytes - bytes uploaded
+*           const std::string & args - args for the command stream
+************************************************************************/
+void CNullGL::Record( const char * pName, NNullGL::ECallType type, size_t bytes, const std::string & args )
+{
+    ++m_stats.callCount;
+
+    if( type == NNullGL::ECT_STATE )
+        ++m_stats.stateChangeCount;
+
+    else if( type == NNullGL::ECT_UPLOAD )
+    {
+        ++m_stats.uploadCount;
+        m_stats.uploadBytes += bytes;
+    }
+    else if( type == NNullGL::ECT_OBJECT )
+        ++m_stats.objectCount;
+
+    CountCall( pName, m_callCountVec );
+
+    if( m_recording )
+        m_commandStreamVec.push_back( std::string(pName) + "(" + args + ")" );
+
+}   // Record
+
+
+/************************************************************************
+*    desc:  Count a draw
+************************************************************************/
+void CNullGL::RecordDraw( size_t indexCount, size_t instanceCount )
+{
+    ++m_stats.drawCount;
+    m_stats.indexCount += indexCount * instanceCount;
+    m_stats.instanceCount += instanceCount;
+
+}   // RecordDraw
+
+
+/************************************************************************
+*    desc:  Add a call to the per function counts. There's only a few
+*           dozen functions so a search is fine.
+************************************************************************/
+void CNullGL::CountCall( const char * pName, std::vector<std::pair<const char *, int>> & rCountVec )
+{
+    for( auto & iter : rCountVec )
+    {
+        if( iter.first == pName )
+        {
+            ++iter.second;
+            return;
+        }
+    }
+
+    rCountVec.emplace_back( pName, 1 );
+
+}   // CountCall
+
+
+/************************************************************************
+*    desc:  Keep the command stream or not
+************************************************************************/
+void CNullGL::SetRecording( bool recording )
+{
+    m_recording = recording;
+
+}   // SetRecording
+
+bool CNullGL::IsRecording() const
+{
+    return m_recording;
+
+}   // IsRecording
+
+
+/************************************************************************
+*    desc:  Set what the GLEW version and extension checks report
+************************************************************************/
+void CNullGL::SetFeaturesAvailable( bool available )
+{
+    m_featuresAvailable = available;
+
+}   // SetFeaturesAvailable
+
+bool CNullGL::IsFeaturesAvailable() const
+{
+    return m_featuresAvailable;
+
+}   // IsFeaturesAvailable
+
+
+/************************************************************************
+*    desc:  Save this frame's counts and clear them for the next frame
+************************************************************************/
+void CNullGL::EndFrame()
+{
+    const auto now = std::chrono::high_resolution_clock::now();
+
+    m_stats.cpuTime = std::chrono::duration<double, std::milli>( now - m_frameStart ).count();
+    m_frameStart = now;
+
+    m_lastStats = m_stats;
+    m_stats = CNullGLStats();
+
+    m_lastCallCountVec.swap( m_callCountVec );
+    m_callCountVec.clear();
+
+    if( m_recording )
+        m_commandStreamVec.push_back( "EndFrame" );
+
+}   // EndFrame
+
+
+/************************************************************************
+*    desc:  Counts of the last frame and of the frame so far
+************************************************************************/
+const CNullGLStats & CNullGL::GetFrameStats() const
+{
+    return m_lastStats;
+
+}   // GetFrameStats
+
+const CNullGLStats & CNullGL::GetCurrentStats() const
+{
+    return m_stats;
+
+}   // GetCurrentStats
+
+
+/************************************************************************
+*    desc:  Number of calls of a GL function in the last frame
+************************************************************************/
+int CNullGL::GetCallCount( const std::string & name ) const
+{
+    for( auto & iter : m_lastCallCountVec )
+    {
+        if( name == iter.first )
+            return iter.second;
+    }
+
+    return 0;
+
+}   // GetCallCount
+
+
+/************************************************************************
+*    desc:  The command stream
+************************************************************************/
+const std::vector<std::string> & CNullGL::GetCommandStream() const
+{
+    return m_commandStreamVec;
+
+}   // GetCommandStream
+
+void CNullGL::DumpCommandStream( const std::string & filePath ) const
+{
+    std::ofstream file( filePath.c_str() );
+
+    for( auto & iter : m_commandStreamVec )
+        file << iter << "\n";
+
+}   // DumpCommandStream
+
+void CNullGL::ClearCommandStream()
+{
+    m_commandStreamVec.clear();
+
+}   // ClearCommandStream
+
+
+/************************************************************************
+*    desc:  Give out object names. All object types share the one count
+*           so a name is never reused.
+************************************************************************/
+GLuint CNullGL::GenName()
+{
+    return m_nextName++;
+
+}   // GenName
+
+
+/************************************************************************
+*    desc:  Attribute locations. Unbound attributes get the next free
+*           location of the program.
+************************************************************************/
+void CNullGL::BindAttribLocation( GLuint programID, GLuint location, const std::string & name )
+{
+    m_attribLocationVec.push_back( {programID, name, (GLint)location} );
+
+}   // BindAttribLocation
+
+GLint CNullGL::GetAttribLocation( GLuint programID, const std::string & name )
+{
+    GLint location = 0;
+
+    for( auto & iter : m_attribLocationVec )
+    {
+        if( iter.programID == programID )
+        {
+            if( iter.name == name )
+                return iter.location;
+
+            if( iter.location >= location )
+                location = iter.location + 1;
+        }
+    }
+
+    m_attribLocationVec.push_back( {programID, name, location} );
+
+    return location;
+
+}   // GetAttribLocation
+
+
+/************************************************************************
+*    desc:  Uniform locations are given out in the order asked for
+************************************************************************/
+GLint CNullGL::GetUniformLocation( GLuint programID, const std::string & name )
+{
+    GLint location = 0;
+
+    for( auto & iter : m_uniformLocationVec )
+    {
+        if( iter.programID == programID )
+        {
+            if( iter.name == name )
+                return iter.location;
+
+            ++location;
+        }
+    }
+
+    m_uniformLocationVec.push_back( {programID, name, location} );
+
+    return location;
+
+}   // GetUniformLocation
+
+
+namespace NNullGL
+{
+    /************************************************************************
+    *    desc:  GLEW
+    ************************************************************************/
+    GLboolean experimental = GL_FALSE;
+
+    GLenum GlewInit()
+    {
+        return GLEW_OK;
+    }
+
+    const GLubyte * GlewGetErrorString( GLenum /*error*/ )
+    {
+        return reinterpret_cast<const GLubyte *>("Null GL backend");
+    }
+
+    bool IsFeatureAvailable()
+    {
+        return CNullGL::Instance().IsFeaturesAvailable();
+    }
+
+
+    /************************************************************************
+    *    desc:  Buffers
+    ************************************************************************/
+    void GenBuffers( GLsizei n, GLuint * pBuffers )
+    {
+        for( GLsizei i = 0; i < n; ++i )
+            pBuffers[i] = CNullGL::Instance().GenName();
+
+        CNullGL::Instance().Record( "glGenBuffers", ECT_OBJECT, 0, Args(n) );
+    }
+
+    void DeleteBuffers( GLsizei n, const GLuint * pBuffers )
+    {
+        CNullGL::Instance().Record( "glDeleteBuffers", ECT_OBJECT, 0, Args(n, pBuffers[0]) );
+
+        // Deleting a buffer unmaps and unbinds it
+        for( GLsizei i = 0; i < n; ++i )
+        {
+            mappedMemMap.erase( pBuffers[i] );
+
+            for( auto & iter : boundBufferMap )
+            {
+                if( iter.second == pBuffers[i] )
+                    iter.second = 0;
+            }
+        }
+    }
+
+    void BindBuffer( GLenum target, GLuint buffer )
+    {
+        boundBufferMap[target] = buffer;
+
+        CNullGL::Instance().Record( "glBindBuffer", ECT_STATE, 0, Args(target, buffer) );
+    }
+
+    void BufferData( GLenum target, GLsizeiptr size, const void * pData, GLenum usage )
+    {
+        // Without data this only allocates or orphans the buffer
+        if( pData != nullptr )
+            CNullGL::Instance().Record( "glBufferData", ECT_UPLOAD, size, Args(target, size, "data", usage) );
+        else
+            CNullGL::Instance().Record( "glBufferData", ECT_OTHER, 0, Args(target, size, "null", usage) );
+    }
+
+    void BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void * /*pData*/ )
+    {
+        CNullGL::Instance().Record( "glBufferSubData", ECT_UPLOAD, size, Args(target, offset, size) );
+    }
+
+    void BindBufferBase( GLenum target, GLuint index, GLuint buffer )
+    {
+        CNullGL::Instance().Record( "glBindBufferBase", ECT_STATE, 0, Args(target, index, buffer) );
+    }
+
+    void BufferStorage( GLenum target, GLsizeiptr size, const void * /*pData*/, GLbitfield flags )
+    {
+        CNullGL::Instance().Record( "glBufferStorage", ECT_OTHER, 0, Args(target, size, flags) );
+    }
+
+    void * MapBufferRange( GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access )
+    {
+        // Writes to the mapping aren't seen by the backend so they aren't counted as uploads
+        CNullGL::Instance().Record( "glMapBufferRange", ECT_OTHER, 0, Args(target, offset, length, access) );
+
+        std::unique_ptr<unsigned char[]> & rupMem = mappedMemMap[boundBufferMap[target]];
+        rupMem.reset( new unsigned char[length] );
+
+        return rupMem.get();
+    }
+
+    GLboolean UnmapBuffer( GLenum target )
+    {
+        mappedMemMap.erase( boundBufferMap[target] );
+
+        CNullGL::Instance().Record( "glUnmapBuffer", ECT_OTHER, 0, Args(target) );
+
+        return GL_TRUE;
+    }
+
+
+    /************************************************************************
+    *    desc:  Sync objects. Nothing is rendered so they are always signaled.
+    ************************************************************************/
+    GLsync FenceSync( GLenum condition, GLbitfield flags )
+    {
+        CNullGL::Instance().Record( "glFenceSync", ECT_OBJECT, 0, Args(condition, flags) );
+
+        return reinterpret_cast<GLsync>( static_cast<size_t>(CNullGL::Instance().GenName()) );
+    }
+
+    GLenum ClientWaitSync( GLsync sync, GLbitfield flags, GLuint64 timeout )
+    {
+        CNullGL::Instance().Record( "glClientWaitSync", ECT_OTHER, 0, Args(sync, flags, timeout) );
+
+        return GL_ALREADY_SIGNALED;
+    }
+
+    void DeleteSync( GLsync sync )
+    {
+        CNullGL::Instance().Record( "glDeleteSync", ECT_OBJECT, 0, Args(sync) );
+    }
+
+
+    /************************************************************************
+    *    desc:  Vertex arrays and attributes
+    ************************************************************************/
+    void GenVertexArrays( GLsizei n, GLuint * pArrays )
+    {
+        for( GLsizei i = 0; i < n; ++i )
+            pArrays[i] = CNullGL::Instance().GenName();
+
+        CNullGL::Instance().Record( "glGenVertexArrays", ECT_OBJECT, 0, Args(n) );
+    }
+
+    void DeleteVertexArrays( GLsizei n, const GLuint * pArrays )
+    {
+        CNullGL::Instance().Record( "glDeleteVertexArrays", ECT_OBJECT, 0, Args(n, pArrays[0]) );
+    }
+
+    void BindVertexArray( GLuint array )
+    {
+        CNullGL::Instance().Record( "glBindVertexArray", ECT_STATE, 0, Args(array) );
+    }
+
+    void EnableVertexAttribArray( GLuint index )
+    {
+        CNullGL::Instance().Record( "glEnableVertexAttribArray", ECT_STATE, 0, Args(index) );
+    }
+
+    void DisableVertexAttribArray( GLuint index )
+    {
+        CNullGL::Instance().Record( "glDisableVertexAttribArray", ECT_STATE, 0, Args(index) );
+    }
+
+    void VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pPointer )
+    {
+        CNullGL::Instance().Record( "glVertexAttribPointer", ECT_STATE, 0,
+            Args(index, size, type, (int)normalized, stride, reinterpret_cast<size_t>(pPointer)) );
+    }
+
+    void VertexAttribDivisor( GLuint index, GLuint divisor )
+    {
+        CNullGL::Instance().Record( "glVertexAttribDivisor", ECT_STATE, 0, Args(index, divisor) );
+    }
+
+    void VertexAttrib4f( GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w )
+    {
+        CNullGL::Instance().Record( "glVertexAttrib4f", ECT_STATE, 0, Args(index, x, y, z, w) );
+    }
+
+
+    /************************************************************************
+    *    desc:  Shaders. Compiles and links always pass.
+    ************************************************************************/
+    GLuint CreateShader( GLenum type )
+    {
+        const GLuint shader = CNullGL::Instance().GenName();
+        CNullGL::Instance().Record( "glCreateShader", ECT_OBJECT, 0, Args(type) );
+
+        return shader;
+    }
+
+    void DeleteShader( GLuint shader )
+    {
+        CNullGL::Instance().Record( "glDeleteShader", ECT_OBJECT, 0, Args(shader) );
+    }
+
+    void ShaderSource( GLuint shader, GLsizei count, const GLchar * const * /*pString*/, const GLint * /*pLength*/ )
+    {
+        CNullGL::Instance().Record( "glShaderSource", ECT_OTHER, 0, Args(shader, count) );
+    }
+
+    void CompileShader( GLuint shader )
+    {
+        CNullGL::Instance().Record( "glCompileShader", ECT_OTHER, 0, Args(shader) );
+    }
+
+    void GetShaderiv( GLuint shader, GLenum pname, GLint * pParams )
+    {
+        *pParams = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 1;
+        CNullGL::Instance().Record( "glGetShaderiv", ECT_OTHER, 0, Args(shader, pname) );
+    }
+
+    void GetShaderInfoLog( GLuint shader, GLsizei bufSize, GLsizei * pLength, GLchar * pInfoLog )
+    {
+        if( pLength != nullptr )
+            *pLength = 0;
+
+        if( bufSize > 0 )
+            pInfoLog[0] = 0;
+
+        CNullGL::Instance().Record( "glGetShaderInfoLog", ECT_OTHER, 0, Args(shader) );
+    }
+
+    GLuint CreateProgram()
+    {
+        const GLuint program = CNullGL::Instance().GenName();
+        CNullGL::Instance().Record( "glCreateProgram", ECT_OBJECT );
+
+        return program;
+    }
+
+    void DeleteProgram( GLuint program )
+    {
+        CNullGL::Instance().Record( "glDeleteProgram", ECT_OBJECT, 0, Args(program) );
+    }
+
+    void AttachShader( GLuint program, GLuint shader )
+    {
+        CNullGL::Instance().Record( "glAttachShader", ECT_OTHER, 0, Args(program, shader) );
+    }
+
+    void BindAttribLocation( GLuint program, GLuint index, const GLchar * pName )
+    {
+        CNullGL::Instance().BindAttribLocation( program, index, pName );
+        CNullGL::Instance().Record( "glBindAttribLocation", ECT_OTHER, 0, Args(program, index, pName) );
+    }
+
+    void LinkProgram( GLuint program )
+    {
+        CNullGL::Instance().Record( "glLinkProgram", ECT_OTHER, 0, Args(program) );
+    }
+
+    void GetProgramiv( GLuint program, GLenum pname, GLint * pParams )
+    {
+        *pParams = (pname == GL_LINK_STATUS) ? GL_TRUE : 1;
+        CNullGL::Instance().Record( "glGetProgramiv", ECT_OTHER, 0, Args(program, pname) );
+    }
+
+    GLint GetAttribLocation( GLuint program, const GLchar * pName )
+    {
+        CNullGL::Instance().Record( "glGetAttribLocation", ECT_OTHER, 0, Args(program, pName) );
+        return CNullGL::Instance().GetAttribLocation( program, pName );
+    }
+
+    GLint GetUniformLocation( GLuint program, const GLchar * pName )
+    {
+        CNullGL::Instance().Record( "glGetUniformLocation", ECT_OTHER, 0, Args(program, pName) );
+        return CNullGL::Instance().GetUniformLocation( program, pName );
+    }
+
+    void UseProgram( GLuint program )
+    {
+        CNullGL::Instance().Record( "glUseProgram", ECT_STATE, 0, Args(program) );
+    }
+
+    void Uniform1i( GLint location, GLint v0 )
+    {
+        CNullGL::Instance().Record( "glUniform1i", ECT_STATE, 0, Args(location, v0) );
+    }
+
+    void Uniform4fv( GLint location, GLsizei count, const GLfloat * pValue )
+    {
+        CNullGL::Instance().Record( "glUniform4fv", ECT_STATE, 0, Args(location, count, pValue[0], pValue[1], pValue[2], pValue[3]) );
+    }
+
+    void UniformMatrix4fv( GLint location, GLsizei count, GLboolean /*transpose*/, const GLfloat * pValue )
+    {
+        CNullGL::Instance().Record( "glUniformMatrix4fv", ECT_STATE, 0, Args(location, count, pValue[12], pValue[13], pValue[14]) );
+    }
+
+    GLuint GetUniformBlockIndex( GLuint program, const GLchar * pName )
+    {
+        // The shaders aren't compiled so every program is taken to have the block
+        CNullGL::Instance().Record( "glGetUniformBlockIndex", ECT_OTHER, 0, Args(program, pName) );
+        return 0;
+    }
+
+    void UniformBlockBinding( GLuint program, GLuint blockIndex, GLuint blockBinding )
+    {
+        CNullGL::Instance().Record( "glUniformBlockBinding", ECT_STATE, 0, Args(program, blockIndex, blockBinding) );
+    }
+
+
+    /************************************************************************
+    *    desc:  Textures
+    ************************************************************************/
+    void GenTextures( GLsizei n, GLuint * pTextures )
+    {
+        for( GLsizei i = 0; i < n; ++i )
+            pTextures[i] = CNullGL::Instance().GenName();
+
+        CNullGL::Instance().Record( "glGenTextures", ECT_OBJECT, 0, Args(n) );
+    }
+
+    void DeleteTextures( GLsizei n, const GLuint * pTextures )
+    {
+        CNullGL::Instance().Record( "glDeleteTextures", ECT_OBJECT, 0, Args(n, pTextures[0]) );
+    }
+
+    void ActiveTexture( GLenum texture )
+    {
+        CNullGL::Instance().Record( "glActiveTexture", ECT_STATE, 0, Args(texture) );
+    }
+
+    void BindTexture( GLenum target, GLuint texture )
+    {
+        CNullGL::Instance().Record( "glBindTexture", ECT_STATE, 0, Args(target, texture) );
+    }
+
+    void TexImage2D( GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint /*border*/, GLenum format, GLenum type, const void * pPixels )
+    {
+        const size_t bytes = (pPixels != nullptr) ? width * height * GetBytesPerPixel( format ) : 0;
+
+        CNullGL::Instance().Record( "glTexImage2D", ECT_UPLOAD, bytes, Args(target, level, internalformat, width, height, format, type) );
+    }
+
+    void TexParameteri( GLenum target, GLenum pname, GLint param )
+    {
+        CNullGL::Instance().Record( "glTexParameteri", ECT_STATE, 0, Args(target, pname, param) );
+    }
+
+
+    /************************************************************************
+    *    desc:  State
+    ************************************************************************/
+    void GetIntegerv( GLenum pname, GLint * pData )
+    {
+        if( pname == GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT )
+            *pData = 16;
+        else
+            *pData = 0;
+
+        CNullGL::Instance().Record( "glGetIntegerv", ECT_OTHER, 0, Args(pname) );
+    }
+
+    void Enable( GLenum cap )
+    {
+        CNullGL::Instance().Record( "glEnable", ECT_STATE, 0, Args(cap) );
+    }
+
+    void Disable( GLenum cap )
+    {
+        CNullGL::Instance().Record( "glDisable", ECT_STATE, 0, Args(cap) );
+    }
+
+    void BlendFunc( GLenum sfactor, GLenum dfactor )
+    {
+        CNullGL::Instance().Record( "glBlendFunc", ECT_STATE, 0, Args(sfactor, dfactor) );
+    }
+
+    void DepthMask( GLboolean flag )
+    {
+        CNullGL::Instance().Record( "glDepthMask", ECT_STATE, 0, Args((int)flag) );
+    }
+
+    void DepthFunc( GLenum func )
+    {
+        CNullGL::Instance().Record( "glDepthFunc", ECT_STATE, 0, Args(func) );
+    }
+
+    void Scissor( GLint x, GLint y, GLsizei width, GLsizei height )
+    {
+        CNullGL::Instance().Record( "glScissor", ECT_STATE, 0, Args(x, y, width, height) );
+    }
+
+    void Viewport( GLint x, GLint y, GLsizei width, GLsizei height )
+    {
+        CNullGL::Instance().Record( "glViewport", ECT_STATE, 0, Args(x, y, width, height) );
+    }
+
+    void ClearColor( GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha )
+    {
+        CNullGL::Instance().Record( "glClearColor", ECT_STATE, 0, Args(red, green, blue, alpha) );
+    }
+
+    void Clear( GLbitfield mask )
+    {
+        CNullGL::Instance().Record( "glClear", ECT_OTHER, 0, Args(mask) );
+    }
+
+
+    /************************************************************************
+    *    desc:  Draws
+    ************************************************************************/
+    void DrawArrays( GLenum mode, GLint first, GLsizei count )
+    {
+        CNullGL::Instance().RecordDraw( count, 1 );
+        CNullGL::Instance().Record( "glDrawArrays", ECT_DRAW, 0, Args(mode, first, count) );
+    }
+
+    void DrawElements( GLenum mode, GLsizei count, GLenum type, const void * pIndices )
+    {
+        CNullGL::Instance().RecordDraw( count, 1 );
+        CNullGL::Instance().Record( "glDrawElements", ECT_DRAW, 0, Args(mode, count, type, reinterpret_cast<size_t>(pIndices)) );
+    }
+
+    void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, const void * pIndices, GLsizei instancecount )
+    {
+        CNullGL::Instance().RecordDraw( count, instancecount );
+        CNullGL::Instance().Record( "glDrawElementsInstanced", ECT_DRAW, 0, Args(mode, count, type, reinterpret_cast<size_t>(pIndices), instancecount) );
+    }
+
+    void DrawElementsBaseVertex( GLenum mode, GLsizei count, GLenum type, const void * pIndices, GLint basevertex )
+    {
+        CNullGL::Instance().RecordDraw( count, 1 );
+        CNullGL::Instance().Record( "glDrawElementsBaseVertex", ECT_DRAW, 0, Args(mode, count, type, reinterpret_cast<size_t>(pIndices), basevertex) );
+    }
+
+    void DrawElementsInstancedBaseVertex( GLenum mode, GLsizei count, GLenum type, const void * pIndices, GLsizei instancecount, GLint basevertex )
+    {
+        CNullGL::Instance().RecordDraw( count, instancecount );
+        CNullGL::Instance().Record( "glDrawElementsInstancedBaseVertex", ECT_DRAW, 0,
+            Args(mode, count, type, reinterpret_cast<size_t>(pIndices), instancecount, basevertex) );
+    }
+}
+
+#endif  // NULL_GL_BACKEND
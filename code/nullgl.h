@@ -0,0 +1,426 @@
+/************************************************************************
+*    FILE NAME:       nullgl.h
+*
+*    DESCRIPTION:     Null GL backend for headless builds. When the game
+*                     is built with NULL_GL_BACKEND defined, the GL calls
+*                     of the engine go here instead of to the driver.
+*                     Nothing is rendered. The calls, state changes,
+*                     buffer uploads and draws are counted per frame and
+*                     the command stream can be recorded for diffing.
+*
+*                     Include after the GL headers in every file that
+*                     makes GL calls. Build with nullgl.cpp in place of
+*                     the GL and GLEW libraries.
+************************************************************************/
+
+#ifndef __null_gl_h__
+#define __null_gl_h__
+
+#if defined(NULL_GL_BACKEND)
+
+// The real GL headers have to be included before the defines below
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <GL/glew.h>
+#include <SDL_opengl.h>
+#endif
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <chrono>
+
+namespace NNullGL
+{
+    // The kind of call for the frame stats
+    enum ECallType
+    {
+        ECT_OTHER,
+        ECT_STATE,
+        ECT_UPLOAD,
+        ECT_DRAW,
+        ECT_OBJECT
+    };
+}
+
+/************************************************************************
+*    desc:  Counts of one frame
+************************************************************************/
+class CNullGLStats
+{
+public:
+
+    CNullGLStats() :
+        callCount(0),
+        stateChangeCount(0),
+        uploadCount(0),
+        uploadBytes(0),
+        drawCount(0),
+        indexCount(0),
+        instanceCount(0),
+        objectCount(0),
+        cpuTime(0)
+    {}
+
+    // All the GL calls
+    int callCount;
+
+    // Binds, enables and uniforms
+    int stateChangeCount;
+
+    // Buffer and texture uploads
+    int uploadCount;
+    size_t uploadBytes;
+
+    // Draw calls, the indices drawn and the instances drawn
+    int drawCount;
+    size_t indexCount;
+    size_t instanceCount;
+
+    // Objects created or deleted
+    int objectCount;
+
+    // CPU time of the frame in milliseconds
+    double cpuTime;
+};
+
+class CNullGL
+{
+public:
+
+    // Get the instance of the singleton class
+    static CNullGL & Instance()
+    {
+        static CNullGL nullGL;
+        return nullGL;
+    }
+
+    // Count a call. When recording, the call and args are added to the command stream.
+    void Record( const char * pName, NNullGL::ECallType type, size_t bytes = 0, const std::string & args = std::string() );
+
+    // Count a draw
+    void RecordDraw( size_t indexCount, size_t instanceCount );
+
+    // Keep the command stream or not. It's off by default.
+    void SetRecording( bool recording );
+    bool IsRecording() const;
+
+    // Set what the GLEW version and extension checks report. The
+    // managers check once so set this before the first render.
+    void SetFeaturesAvailable( bool available );
+    bool IsFeaturesAvailable() const;
+
+    // Save this frame's counts and clear them for the next frame
+    void EndFrame();
+
+    // Counts of the last frame and of the frame so far
+    const CNullGLStats & GetFrameStats() const;
+    const CNullGLStats & GetCurrentStats() const;
+
+    // Number of calls of a GL function in the last frame. ex: "glBindBuffer"
+    int GetCallCount( const std::string & name ) const;
+
+    // The command stream. Frames are split by an "EndFrame" line.
+    const std::vector<std::string> & GetCommandStream() const;
+    void DumpCommandStream( const std::string & filePath ) const;
+    void ClearCommandStream();
+
+    // Give out object names and attribute and uniform locations
+    GLuint GenName();
+    void BindAttribLocation( GLuint programID, GLuint location, const std::string & name );
+    GLint GetAttribLocation( GLuint programID, const std::string & name );
+    GLint GetUniformLocation( GLuint programID, const std::string & name );
+
+private:
+
+    // Constructor
+    CNullGL();
+
+    // Destructor
+    ~CNullGL();
+
+    // Add a call to the per function counts
+    void CountCall( const char * pName, std::vector<std::pair<const char *, int>> & rCountVec );
+
+private:
+
+    bool m_recording;
+    bool m_featuresAvailable;
+
+    CNullGLStats m_stats;
+    CNullGLStats m_lastStats;
+
+    // Per function counts. The names are the string literals of the
+    // backend so they are compared by pointer while counting.
+    std::vector<std::pair<const char *, int>> m_callCountVec;
+    std::vector<std::pair<const char *, int>> m_lastCallCountVec;
+
+    std::vector<std::string> m_commandStreamVec;
+
+    // Next object name
+    GLuint m_nextName;
+
+    // Locations of each program
+    class CLocation
+    {
+    public:
+        GLuint programID;
+        std::string name;
+        GLint location;
+    };
+
+    std::vector<CLocation> m_attribLocationVec;
+    std::vector<CLocation> m_uniformLocationVec;
+
+    // Start of the frame
+    std::chrono::high_resolution_clock::time_point m_frameStart;
+};
+
+namespace NNullGL
+{
+    // GLEW
+    extern GLboolean experimental;
+    GLenum GlewInit();
+    const GLubyte * GlewGetErrorString( GLenum error );
+    bool IsFeatureAvailable();
+
+    // Buffers
+    void GenBuffers( GLsizei n, GLuint * pBuffers );
+    void DeleteBuffers( GLsizei n, const GLuint * pBuffers );
+    void BindBuffer( GLenum target, GLuint buffer );
+    void BufferData( GLenum target, GLsizeiptr size, const void * pData, GLenum usage );
+    void BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void * pData );
+    void BindBufferBase( GLenum target, GLuint index, GLuint buffer );
+    void BufferStorage( GLenum target, GLsizeiptr size, const void * pData, GLbitfield flags );
+    void * MapBufferRange( GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access );
+    GLboolean UnmapBuffer( GLenum target );
+
+    // Sync objects
+    GLsync FenceSync( GLenum condition, GLbitfield flags );
+    GLenum ClientWaitSync( GLsync sync, GLbitfield flags, GLuint64 timeout );
+    void DeleteSync( GLsync sync );
+
+    // Vertex arrays and attributes
+    void GenVertexArrays( GLsizei n, GLuint * pArrays );
+    void DeleteVertexArrays( GLsizei n, const GLuint * pArrays );
+    void BindVertexArray( GLuint array );
+    void EnableVertexAttribArray( GLuint index );
+    void DisableVertexAttribArray( GLuint index );
+    void VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pPointer );
+    void VertexAttribDivisor( GLuint index, GLuint divisor );
+    void VertexAttrib4f( GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w );
+
+    // Shaders
+    GLuint CreateShader( GLenum type );
+    void DeleteShader( GLuint shader );
+    void ShaderSource( GLuint shader, GLsizei count, const GLchar * const * pString, const GLint * pLength );
+    void CompileShader( GLuint shader );
+    void GetShaderiv( GLuint shader, GLenum pname, GLint * pParams );
+    void GetShaderInfoLog( GLuint shader, GLsizei bufSize, GLsizei * pLength, GLchar * pInfoLog );
+    GLuint CreateProgram();
+    void DeleteProgram( GLuint program );
+    void AttachShader( GLuint program, GLuint shader );
+    void BindAttribLocation( GLuint program, GLuint index, const GLchar * pName );
+    void LinkProgram( GLuint program );
+    void GetProgramiv( GLuint program, GLenum pname, GLint * pParams );
+    GLint GetAttribLocation( GLuint program, const GLchar * pName );
+    GLint GetUniformLocation( GLuint program, const GLchar * pName );
+    void UseProgram( GLuint program );
+    void Uniform1i( GLint location, GLint v0 );
+    void Uniform4fv( GLint location, GLsizei count, const GLfloat * pValue );
+    void UniformMatrix4fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat * pValue );
+    GLuint GetUniformBlockIndex( GLuint program, const GLchar * pName );
+    void UniformBlockBinding( GLuint program, GLuint blockIndex, GLuint blockBinding );
+
+    // Textures
+    void GenTextures( GLsizei n, GLuint * pTextures );
+    void DeleteTextures( GLsizei n, const GLuint * pTextures );
+    void ActiveTexture( GLenum texture );
+    void BindTexture( GLenum target, GLuint texture );
+    void TexImage2D( GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pPixels );
+    void TexParameteri( GLenum target, GLenum pname, GLint param );
+
+    // State
+    void GetIntegerv( GLenum pname, GLint * pData );
+    void Enable( GLenum cap );
+    void Disable( GLenum cap );
+    void BlendFunc( GLenum sfactor, GLenum dfactor );
+    void DepthMask( GLboolean flag );
+    void DepthFunc( GLenum func );
+    void Scissor( GLint x, GLint y, GLsizei width, GLsizei height );
+    void Viewport( GLint x, GLint y, GLsizei width, GLsizei height );
+    void ClearColor( GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha );
+    void Clear( GLbitfield mask );
+
+    // Draws
+    void DrawArrays( GLenum mode, GLint first, GLsizei count );
+    void DrawElements( GLenum mode, GLsizei count, GLenum type, const void * pIndices );
+    void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, const void * pIndices, GLsizei instancecount );
+    void DrawElementsBaseVertex( GLenum mode, GLsizei count, GLenum type, const void * pIndices, GLint basevertex );
+    void DrawElementsInstancedBaseVertex( GLenum mode, GLsizei count, GLenum type, const void * pIndices, GLsizei instancecount, GLint basevertex );
+}
+
+// Send the GL calls to the null backend
+#undef glewExperimental
+#undef glewInit
+#undef glewGetErrorString
+#undef GLEW_VERSION_3_0
+#undef GLEW_VERSION_3_1
+#undef GLEW_VERSION_3_2
+#undef GLEW_VERSION_3_3
+#undef GLEW_ARB_vertex_array_object
+#undef GLEW_ARB_instanced_arrays
+#undef GLEW_ARB_draw_instanced
+#undef GLEW_ARB_draw_elements_base_vertex
+#undef GLEW_VERSION_4_4
+#undef GLEW_ARB_buffer_storage
+#undef GLEW_ARB_uniform_buffer_object
+#define glewExperimental                NNullGL::experimental
+#define glewInit                        NNullGL::GlewInit
+#define glewGetErrorString              NNullGL::GlewGetErrorString
+#define GLEW_VERSION_3_0                NNullGL::IsFeatureAvailable()
+#define GLEW_VERSION_3_1                NNullGL::IsFeatureAvailable()
+#define GLEW_VERSION_3_2                NNullGL::IsFeatureAvailable()
+#define GLEW_VERSION_3_3                NNullGL::IsFeatureAvailable()
+#define GLEW_ARB_vertex_array_object    NNullGL::IsFeatureAvailable()
+#define GLEW_ARB_instanced_arrays       NNullGL::IsFeatureAvailable()
+#define GLEW_ARB_draw_instanced         NNullGL::IsFeatureAvailable()
+#define GLEW_ARB_draw_elements_base_vertex  NNullGL::IsFeatureAvailable()
+#define GLEW_VERSION_4_4                NNullGL::IsFeatureAvailable()
+#define GLEW_ARB_buffer_storage         NNullGL::IsFeatureAvailable()
+#define GLEW_ARB_uniform_buffer_object  NNullGL::IsFeatureAvailable()
+
+#undef glGenBuffers
+#undef glDeleteBuffers
+#undef glBindBuffer
+#undef glBufferData
+#undef glBufferSubData
+#undef glBindBufferBase
+#undef glBufferStorage
+#undef glMapBufferRange
+#undef glUnmapBuffer
+#define glGenBuffers                    NNullGL::GenBuffers
+#define glDeleteBuffers                 NNullGL::DeleteBuffers
+#define glBindBuffer                    NNullGL::BindBuffer
+#define glBufferData                    NNullGL::BufferData
+#define glBufferSubData                 NNullGL::BufferSubData
+#define glBindBufferBase                NNullGL::BindBufferBase
+#define glBufferStorage                 NNullGL::BufferStorage
+#define glMapBufferRange                NNullGL::MapBufferRange
+#define glUnmapBuffer                   NNullGL::UnmapBuffer
+
+#undef glFenceSync
+#undef glClientWaitSync
+#undef glDeleteSync
+#define glFenceSync                     NNullGL::FenceSync
+#define glClientWaitSync                NNullGL::ClientWaitSync
+#define glDeleteSync                    NNullGL::DeleteSync
+
+#undef glGenVertexArrays
+#undef glDeleteVertexArrays
+#undef glBindVertexArray
+#undef glEnableVertexAttribArray
+#undef glDisableVertexAttribArray
+#undef glVertexAttribPointer
+#undef glVertexAttribDivisor
+#undef glVertexAttrib4f
+#define glGenVertexArrays               NNullGL::GenVertexArrays
+#define glDeleteVertexArrays            NNullGL::DeleteVertexArrays
+#define glBindVertexArray               NNullGL::BindVertexArray
+#define glEnableVertexAttribArray       NNullGL::EnableVertexAttribArray
+#define glDisableVertexAttribArray      NNullGL::DisableVertexAttribArray
+#define glVertexAttribPointer           NNullGL::VertexAttribPointer
+#define glVertexAttribDivisor           NNullGL::VertexAttribDivisor
+#define glVertexAttrib4f                NNullGL::VertexAttrib4f
+
+#undef glCreateShader
+#undef glDeleteShader
+#undef glShaderSource
+#undef glCompileShader
+#undef glGetShaderiv
+#undef glGetShaderInfoLog
+#undef glCreateProgram
+#undef glDeleteProgram
+#undef glAttachShader
+#undef glBindAttribLocation
+#undef glLinkProgram
+#undef glGetProgramiv
+#undef glGetAttribLocation
+#undef glGetUniformLocation
+#undef glUseProgram
+#undef glUniform1i
+#undef glUniform4fv
+#undef glUniformMatrix4fv
+#undef glGetUniformBlockIndex
+#undef glUniformBlockBinding
+#define glCreateShader                  NNullGL::CreateShader
+#define glDeleteShader                  NNullGL::DeleteShader
+#define glShaderSource                  NNullGL::ShaderSource
+#define glCompileShader                 NNullGL::CompileShader
+#define glGetShaderiv                   NNullGL::GetShaderiv
+#define glGetShaderInfoLog              NNullGL::GetShaderInfoLog
+#define glCreateProgram                 NNullGL::CreateProgram
+#define glDeleteProgram                 NNullGL::DeleteProgram
+#define glAttachShader                  NNullGL::AttachShader
+#define glBindAttribLocation            NNullGL::BindAttribLocation
+#define glLinkProgram                   NNullGL::LinkProgram
+#define glGetProgramiv                  NNullGL::GetProgramiv
+#define glGetAttribLocation             NNullGL::GetAttribLocation
+#define glGetUniformLocation            NNullGL::GetUniformLocation
+#define glUseProgram                    NNullGL::UseProgram
+#define glUniform1i                     NNullGL::Uniform1i
+#define glUniform4fv                    NNullGL::Uniform4fv
+#define glUniformMatrix4fv              NNullGL::UniformMatrix4fv
+#define glGetUniformBlockIndex          NNullGL::GetUniformBlockIndex
+#define glUniformBlockBinding           NNullGL::UniformBlockBinding
+
+#undef glGenTextures
+#undef glDeleteTextures
+#undef glActiveTexture
+#undef glBindTexture
+#undef glTexImage2D
+#undef glTexParameteri
+#define glGenTextures                   NNullGL::GenTextures
+#define glDeleteTextures                NNullGL::DeleteTextures
+#define glActiveTexture                 NNullGL::ActiveTexture
+#define glBindTexture                   NNullGL::BindTexture
+#define glTexImage2D                    NNullGL::TexImage2D
+#define glTexParameteri                 NNullGL::TexParameteri
+
+#undef glGetIntegerv
+#undef glEnable
+#undef glDisable
+#undef glBlendFunc
+#undef glDepthMask
+#undef glDepthFunc
+#undef glScissor
+#undef glViewport
+#undef glClearColor
+#undef glClear
+#define glGetIntegerv                   NNullGL::GetIntegerv
+#define glEnable                        NNullGL::Enable
+#define glDisable                       NNullGL::Disable
+#define glBlendFunc                     NNullGL::BlendFunc
+#define glDepthMask                     NNullGL::DepthMask
+#define glDepthFunc                     NNullGL::DepthFunc
+#define glScissor                       NNullGL::Scissor
+#define glViewport                      NNullGL::Viewport
+#define glClearColor                    NNullGL::ClearColor
+#define glClear                         NNullGL::Clear
+
+#undef glDrawArrays
+#undef glDrawElements
+#undef glDrawElementsInstanced
+#undef glDrawElementsBaseVertex
+#undef glDrawElementsInstancedBaseVertex
+#define glDrawArrays                    NNullGL::DrawArrays
+#define glDrawElements                  NNullGL::DrawElements
+#define glDrawElementsInstanced         NNullGL::DrawElementsInstanced
+#define glDrawElementsBaseVertex        NNullGL::DrawElementsBaseVertex
+#define glDrawElementsInstancedBaseVertex   NNullGL::DrawElementsInstancedBaseVertex
+
+#endif  // NULL_GL_BACKEND
+
+#endif  // __null_gl_h__
@@ -0,0 +1,164 @@
+/************************************************************************
+*    FILE NAME:       numericlayout.cpp
+*
+*    DESCRIPTION:     Layout of a single line string that changes often
+************************************************************************/
+
+// Physical component dependency
+#include <2d/numericlayout.h>
+
+// Game lib dependencies
+#include <2d/textlayout.h>
+#include <common/font.h>
+#include <common/fontproperties.h>
+#include <common/glyphtable.h>
+#include <utilities/utf8.h>
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CNumericLayout::CNumericLayout() :
+    m_spData( new CTextLayoutData ),
+    m_pFont(nullptr),
+    m_kerning(0.f),
+    m_spaceCharKerning(0.f),
+    m_hAlign(NDefs::EHA_HORZ_CENTER),
+    m_vAlign(NDefs::EVA_VERT_CENTER),
+    m_lineOffset(0.f),
+    m_lineHeightOffset(0.f)
+{
+}   // constructor
+
+
+/************************************************************************
+*    desc:  Update the layout to the string
+*
+*    param: const CFont & font - font of the string
+*           const std::string & str - string to lay out
+*           const CFontProperties & fontProp - kerning and alignment
+*
+*    ret:   int - number of quads rebuilt
+************************************************************************/
+int CNumericLayout::Update( const CFont & font, const std::string & str, const CFontProperties & fontProp )
+{
+    // Everything is rebuilt if what the quads were built with changed
+    if( (m_pFont != &font) ||
+        (m_kerning != fontProp.m_kerning) ||
+        (m_spaceCharKerning != fontProp.m_spaceCharKerning) ||
+        (m_hAlign != fontProp.m_hAlign) ||
+        (m_vAlign != fontProp.m_vAlign) )
+    {
+        m_pFont = &font;
+        m_kerning = fontProp.m_kerning;
+        m_spaceCharKerning = fontProp.m_spaceCharKerning;
+        m_hAlign = fontProp.m_hAlign;
+        m_vAlign = fontProp.m_vAlign;
+        m_lineHeightOffset = CTextLayout::CalcLineHeightOffset( font, fontProp, 1 );
+
+        m_glyphVec.clear();
+    }
+
+    const float padding = fontProp.m_kerning + font.GetHorzPadding();
+    float width = 0.f;
+    float maxWidth = 0.f;
+    float lastCharDif = 0.f;
+    float firstCharOffset = 0.f;
+    float lastCharOffset = 0.f;
+
+    // Flag the glyphs that moved or changed
+    const size_t oldCount = m_glyphVec.size();
+    size_t glyphCount = 0;
+
+    const CGlyphTable & glyphTable = font.GetGlyphTable();
+
+    for( size_t i = 0; i < str.size(); )
+    {
+        const bool first = (i == 0);
+        const uint32_t id = NUtf8::Decode( str, i );
+        const CCharData & charData = glyphTable.GetCharData( id );
+
+        if( first )
+            firstCharOffset = charData.offset.w;
+
+        float inc = charData.xAdvance + padding;
+
+        if( id == ' ' )
+        {
+            inc += fontProp.m_spaceCharKerning;
+        }
+        else
+        {
+            if( glyphCount < oldCount )
+            {
+                CGlyph & rGlyph = m_glyphVec[glyphCount];
+                rGlyph.changed = (rGlyph.pCharData != &charData) || (rGlyph.x != width);
+                rGlyph.pCharData = &charData;
+                rGlyph.x = width;
+            }
+            else
+            {
+                m_glyphVec.push_back( {&charData, width, true} );
+            }
+
+            lastCharOffset = charData.offset.w;
+            ++glyphCount;
+        }
+
+        width += inc;
+
+        // Get the longest width of this font string
+        if( maxWidth < width )
+        {
+            maxWidth = width;
+            lastCharDif = inc - charData.rect.x2;
+        }
+    }
+
+    // Drop the glyphs past the end of a shorter string
+    m_glyphVec.resize( glyphCount );
+
+    std::vector<CQuad2D> & rQuadVec = m_spData->quadVec;
+    rQuadVec.resize( glyphCount );
+
+    m_spData->size.w = maxWidth - lastCharDif;
+    m_spData->size.h = font.GetLineHeight();
+
+    // A change in width moves the alignment. The quads that didn't
+    // change are shifted instead of rebuilt.
+    const float lineOffset = CTextLayout::CalcLineOffset( font, fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
+    const float shift = (oldCount > 0) ? (lineOffset - m_lineOffset) : 0.f;
+    m_lineOffset = lineOffset;
+
+    const CSize<float> textureSize = font.GetTextureSize();
+    int rebuildCount = 0;
+
+    for( size_t i = 0; i < glyphCount; ++i )
+    {
+        const CGlyph & glyph = m_glyphVec[i];
+        CQuad2D & rQuad = rQuadVec[i];
+
+        if( glyph.changed )
+        {
+            CTextLayout::BuildGlyphQuad( font, *glyph.pCharData, lineOffset + glyph.x, m_lineHeightOffset, textureSize, rQuad );
+            ++rebuildCount;
+        }
+        else if( shift != 0.f )
+        {
+            for( int j = 0; j < 4; ++j )
+                rQuad.vert[j].vert.x += shift;
+        }
+    }
+
+    return rebuildCount;
+
+}   // Update
+
+
+/************************************************************************
+*    desc:  Get the layout
+************************************************************************/
+std::shared_ptr<const CTextLayoutData> CNumericLayout::GetData() const
+{
+    return m_spData;
+
+}   // GetData
@@ -0,0 +1,67 @@
+/************************************************************************
+*    FILE NAME:       numericlayout.h
+*
+*    DESCRIPTION:     Layout of a single line string that changes often,
+*                     like the credit, bet and win meters. The quads of
+*                     the last string are kept and only the glyphs that
+*                     changed are rebuilt. When the width change moves
+*                     the alignment, the unchanged quads are only shifted.
+*                     Line breaks and line wrap aren't supported.
+************************************************************************/
+
+#ifndef __numeric_layout_h__
+#define __numeric_layout_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <managers/textlayoutcache.h>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <memory>
+
+// Forward declaration(s)
+class CFont;
+class CCharData;
+class CFontProperties;
+
+class CNumericLayout
+{
+public:
+
+    // Constructor
+    CNumericLayout();
+
+    // Update the layout to the string. Returns the number of quads rebuilt.
+    int Update( const CFont & font, const std::string & str, const CFontProperties & fontProp );
+
+    // The layout. It's updated in place so it's only shared with the owner's renders.
+    std::shared_ptr<const CTextLayoutData> GetData() const;
+
+private:
+
+    // A placed glyph of the last string
+    class CGlyph
+    {
+    public:
+        const CCharData * pCharData;
+        float x;
+        bool changed;
+    };
+
+    std::shared_ptr<CTextLayoutData> m_spData;
+    std::vector<CGlyph> m_glyphVec;
+
+    // What the quads were built with
+    const CFont * m_pFont;
+    float m_kerning;
+    float m_spaceCharKerning;
+    NDefs::EHorzAlignment m_hAlign;
+    NDefs::EVertAlignment m_vAlign;
+
+    float m_lineOffset;
+    float m_lineHeightOffset;
+};
+
+#endif  // __numeric_layout_h__
@@ -34,6 +34,8 @@
 CObjectVisualData2D::CObjectVisualData2D() :
     m_vbo(0),
     m_ibo(0),
+    m_baseVertex(0),
+    m_iboOffset(0),
     m_genType(NDefs::EGT_NULL),
     m_textureSequenceCount(0),
     m_compressed(false),
@@ -300,6 +302,10 @@ void CObjectVisualData2D::GenerateQuad( const std::string & group )
     m_vbo = CVertBufMgr::Instance().CreateVBO( group, vboName, vertVec );
     m_ibo = CVertBufMgr::Instance().CreateIBO( group, "quad_0123", indexData, sizeof(indexData) );
 
+    // Where the quad is in the group's arenas
+    m_baseVertex = CVertBufMgr::Instance().GetBaseVertex( group, vboName );
+    m_iboOffset = CVertBufMgr::Instance().GetIBOOffset( group, "quad_0123" );
+
     // A quad has 4 ibos
     m_iboCount = 4;
         
@@ -332,6 +338,10 @@ void CObjectVisualData2D::GenerateScaledFrame(
     // Create the reusable IBO buffer
     m_ibo = CVertBufMgr::Instance().CreateIBO( group, "scaled_frame", indexData, sizeof(indexData) );
 
+    // Where the frame is in the group's arenas
+    m_baseVertex = CVertBufMgr::Instance().GetBaseVertex( group, vboName );
+    m_iboOffset = CVertBufMgr::Instance().GetIBOOffset( group, "scaled_frame" );
+
     // Set the ibo count depending on the number of quads being rendered
     // If the center quad is not used, just adjust the ibo count because
     // the center quad is just reused verts anyways and is that last 6 in the IBO
@@ -390,6 +400,10 @@ void CObjectVisualData2D::GenerateScaledFrameMeshFile(
 		m_iboCount = iboVec.size();
     }
 
+    // Where the mesh is in the group's arenas
+    m_baseVertex = CVertBufMgr::Instance().GetBaseVertex( group, name );
+    m_iboOffset = CVertBufMgr::Instance().GetIBOOffset( group, name );
+
 }   // GenerateScaledFrameMeshFile
 
 
@@ -421,6 +435,10 @@ void CObjectVisualData2D::GenerateFromMeshFile(
 		m_iboCount = iboVec.size();
     }
 
+    // Where the mesh is in the group's arenas
+    m_baseVertex = CVertBufMgr::Instance().GetBaseVertex( group, name );
+    m_iboOffset = CVertBufMgr::Instance().GetIBOOffset( group, name );
+
 }   // GenerateFromMeshFile
 
 
@@ -541,6 +559,24 @@ GLuint CObjectVisualData2D::GetIBO() const
 }
 
 
+/************************************************************************
+*    desc:  Get the first vertex of the VBO in it's arena
+************************************************************************/
+int CObjectVisualData2D::GetBaseVertex() const
+{
+    return m_baseVertex;
+}
+
+
+/************************************************************************
+*    desc:  Get the byte offset of the IBO in it's arena
+************************************************************************/
+int CObjectVisualData2D::GetIBOOffset() const
+{
+    return m_iboOffset;
+}
+
+
 /************************************************************************
 *    desc:  Get the vertex count
 ************************************************************************/
@@ -571,6 +607,15 @@ const CPoint<float> & CObjectVisualData2D::GetVertexScale() const
 }
 
 
+/************************************************************************
+*    desc:  Get the quad's uv
+************************************************************************/
+const CRect<float> & CObjectVisualData2D::GetUV() const 
+{
+    return m_uv;
+}
+
+
 /************************************************************************
 *    desc:  Whether or not the visual tag was specified
 ************************************************************************/
@@ -221,9 +221,9 @@ public:
     *
     *    param:  CPoint & point - point to add
     *
-    *    return: CPoint - added point
+    *    return: CPoint & - added point
     ************************************************************************/
-    CPoint operator += ( const CPoint & point )
+    CPoint & operator += ( const CPoint & point )
     {
         x += point.x;
         y += point.y;
@@ -238,9 +238,9 @@ public:
     *
     *    param:  type value - value to add
     *
-    *    return: CPoint - added point
+    *    return: CPoint & - added point
     ************************************************************************/
-    CPoint operator += ( type value )
+    CPoint & operator += ( type value )
     {
         x += value;
         y += value;
@@ -255,9 +255,9 @@ public:
     *
     *    param:  CPoint & point - point to add
     *
-    *    return: CPoint - added point
+    *    return: CPoint & - added point
     ************************************************************************/
-    CPoint operator -= ( const CPoint & point )
+    CPoint & operator -= ( const CPoint & point )
     {
         x -= point.x;
         y -= point.y;
@@ -272,9 +272,9 @@ public:
     *
     *    param:  type value - value to add
     *
-    *    return: CPoint - added point
+    *    return: CPoint & - added point
     ************************************************************************/
-    CPoint operator -= ( type value )
+    CPoint & operator -= ( type value )
     {
         x -= value;
         y -= value;
@@ -344,9 +344,9 @@ public:
     *
     *    param:  CPoint & point - point to multiply
     *
-    *    return: CPoint - multiplied point
+    *    return: CPoint & - multiplied point
     ************************************************************************/
-    CPoint operator *= ( const CPoint & point )
+    CPoint & operator *= ( const CPoint & point )
     {
         x *= point.x;
         y *= point.y;
@@ -361,9 +361,9 @@ public:
     *
     *    param:  type value - value to multiply
     *
-    *    return: CPoint - multiplied point
+    *    return: CPoint & - multiplied point
     ************************************************************************/
-    CPoint operator *= ( type value )
+    CPoint & operator *= ( type value )
     {
         x *= value;
         y *= value;
@@ -378,9 +378,9 @@ public:
     *
     *    param:  CMatrix & matrix - matrix to multiply
     *
-    *    return: CPoint - multiplied point
+    *    return: CPoint & - multiplied point
     ************************************************************************/
-    CPoint operator *= ( type * pMat )
+    CPoint & operator *= ( type * pMat )
     {
         CPoint tmp;
 
@@ -401,9 +401,9 @@ public:
     *
     *    param:  CPoint & point - point to divide
     *
-    *    return: CPoint - divided point
+    *    return: CPoint & - divided point
     ************************************************************************/
-    CPoint operator /= ( const CPoint & point )
+    CPoint & operator /= ( const CPoint & point )
     {
         x /= point.x;
         y /= point.y;
@@ -418,9 +418,9 @@ public:
     *
     *    param:  type value - value to divide
     *
-    *    return: CPoint - divided point
+    *    return: CPoint & - divided point
     ************************************************************************/
-    CPoint operator /= ( type value )
+    CPoint & operator /= ( type value )
     {
         x /= value;
         y /= value;
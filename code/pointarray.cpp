@@ -0,0 +1,113 @@
+/************************************************************************
+*    FILE NAME:       pointarray.cpp
+*
+*    DESCRIPTION:     SSE2 kernels for the float point array
+************************************************************************/
+
+// Physical component dependency
+#include <common/pointarray.h>
+
+// Game lib dependencies
+#include <common/matrixsimd.h>
+
+#if defined(MATRIX_SIMD_X86)
+    #include <emmintrin.h>
+#endif
+
+#if defined(MATRIX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define POINT_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+    #define POINT_TARGET_SSE2
+#endif
+
+namespace NPointArray
+{
+    #if defined(MATRIX_SIMD_X86)
+
+    /************************************************************************
+    *    desc:  SSE2 kernels. Each does as many blocks of four as it can
+    *           and returns the number done. The remainder is scalar.
+    ************************************************************************/
+    POINT_TARGET_SSE2
+    static size_t GetLengthSSE2( float * pDest, const float * pX, const float * pY, const float * pZ, size_t count )
+    {
+        const size_t blockCount = count & ~size_t(3);
+
+        for( size_t i = 0; i < blockCount; i += 4 )
+        {
+            const __m128 x = _mm_loadu_ps( pX + i );
+            const __m128 y = _mm_loadu_ps( pY + i );
+            const __m128 z = _mm_loadu_ps( pZ + i );
+
+            const __m128 lengthSq = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) );
+
+            _mm_storeu_ps( pDest + i, _mm_sqrt_ps( lengthSq ) );
+        }
+
+        return blockCount;
+
+    }   // GetLengthSSE2
+
+    POINT_TARGET_SSE2
+    static size_t NormalizeSSE2( float * pX, float * pY, float * pZ, size_t count )
+    {
+        const size_t blockCount = count & ~size_t(3);
+        const __m128 one = _mm_set1_ps( 1.0f );
+
+        for( size_t i = 0; i < blockCount; i += 4 )
+        {
+            const __m128 x = _mm_loadu_ps( pX + i );
+            const __m128 y = _mm_loadu_ps( pY + i );
+            const __m128 z = _mm_loadu_ps( pZ + i );
+
+            const __m128 length = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) ) );
+
+            // Zero lengths divide by one so they are left as is
+            const __m128 isZero = _mm_cmpeq_ps( length, _mm_setzero_ps() );
+            const __m128 divisor = _mm_or_ps( _mm_andnot_ps( isZero, length ), _mm_and_ps( isZero, one ) );
+
+            _mm_storeu_ps( pX + i, _mm_div_ps( x, divisor ) );
+            _mm_storeu_ps( pY + i, _mm_div_ps( y, divisor ) );
+            _mm_storeu_ps( pZ + i, _mm_div_ps( z, divisor ) );
+        }
+
+        return blockCount;
+
+    }   // NormalizeSSE2
+
+    #endif  // MATRIX_SIMD_X86
+
+
+    /************************************************************************
+    *    desc:  Get the length of each point
+    ************************************************************************/
+    void GetLength( float * pDest, const float * pX, const float * pY, const float * pZ, size_t count )
+    {
+        size_t i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( NMatrixSimd::GetKernel() != NMatrixSimd::EK_SCALAR )
+            i = GetLengthSSE2( pDest, pX, pY, pZ, count );
+        #endif
+
+        GetLength<float>( pDest + i, pX + i, pY + i, pZ + i, count - i );
+
+    }   // GetLength
+
+
+    /************************************************************************
+    *    desc:  Normalize each point. Zero length points are left as is.
+    ************************************************************************/
+    void Normalize( float * pX, float * pY, float * pZ, size_t count )
+    {
+        size_t i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( NMatrixSimd::GetKernel() != NMatrixSimd::EK_SCALAR )
+            i = NormalizeSSE2( pX, pY, pZ, count );
+        #endif
+
+        Normalize<float>( pX + i, pY + i, pZ + i, count - i );
+
+    }   // Normalize
+}
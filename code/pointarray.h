@@ -0,0 +1,239 @@
+/************************************************************************
+*    FILE NAME:       pointarray.h
+*
+*    DESCRIPTION:     SoA array of points. x, y and z are kept in their
+*                     own arrays so whole array operations vectorize.
+************************************************************************/
+
+#ifndef __point_array_h__
+#define __point_array_h__
+
+// Game lib dependencies
+#include <common/point.h>
+
+// Standard lib dependencies
+#include <vector>
+#include <cmath>
+
+namespace NPointArray
+{
+    // The float versions of the square root operations use SSE2 kernels.
+    // The compiler won't vectorize sqrt on its own because of errno.
+    void GetLength( float * pDest, const float * pX, const float * pY, const float * pZ, size_t count );
+    void Normalize( float * pX, float * pY, float * pZ, size_t count );
+
+    template <class type>
+    void GetLength( type * pDest, const type * pX, const type * pY, const type * pZ, size_t count )
+    {
+        for( size_t i = 0; i < count; ++i )
+            pDest[i] = std::sqrt( (pX[i] * pX[i]) + (pY[i] * pY[i]) + (pZ[i] * pZ[i]) );
+
+    }   // GetLength
+
+    template <class type>
+    void Normalize( type * pX, type * pY, type * pZ, size_t count )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            const type length = std::sqrt( (pX[i] * pX[i]) + (pY[i] * pY[i]) + (pZ[i] * pZ[i]) );
+
+            if( length != 0 )
+            {
+                pX[i] /= length;
+                pY[i] /= length;
+                pZ[i] /= length;
+            }
+        }
+
+    }   // Normalize
+}
+
+template <class type>
+class CPointArray
+{
+public:
+
+    // Point values
+    std::vector<type> x, y, z;
+
+    /************************************************************************
+    *    desc:  Constructor
+    ************************************************************************/
+    CPointArray()
+    {
+    }
+
+    explicit CPointArray( size_t count ) : x(count), y(count), z(count)
+    {
+    }
+
+    /************************************************************************
+    *    desc:  Size management
+    ************************************************************************/
+    size_t size() const
+    {
+        return x.size();
+    }
+
+    void resize( size_t count )
+    {
+        x.resize( count );
+        y.resize( count );
+        z.resize( count );
+    }
+
+    void reserve( size_t count )
+    {
+        x.reserve( count );
+        y.reserve( count );
+        z.reserve( count );
+    }
+
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    void push_back( const CPoint<type> & point )
+    {
+        x.push_back( point.x );
+        y.push_back( point.y );
+        z.push_back( point.z );
+    }
+
+    /************************************************************************
+    *    desc:  Get/Set a single point
+    ************************************************************************/
+    CPoint<type> Get( size_t index ) const
+    {
+        return CPoint<type>( x[index], y[index], z[index] );
+
+    }   // Get
+
+    void Set( size_t index, const CPoint<type> & point )
+    {
+        x[index] = point.x;
+        y[index] = point.y;
+        z[index] = point.z;
+
+    }   // Set
+
+    /************************************************************************
+    *    desc:  Add another array to this one. Arrays must be the same size.
+    ************************************************************************/
+    void Add( const CPointArray & obj )
+    {
+        type * pX = x.data(); type * pY = y.data(); type * pZ = z.data();
+        const type * pObjX = obj.x.data(); const type * pObjY = obj.y.data(); const type * pObjZ = obj.z.data();
+
+        for( size_t i = 0; i < size(); ++i )
+        {
+            pX[i] += pObjX[i];
+            pY[i] += pObjY[i];
+            pZ[i] += pObjZ[i];
+        }
+
+    }   // Add
+
+    /************************************************************************
+    *    desc:  Add a point to all the points in the array
+    ************************************************************************/
+    void Add( const CPoint<type> & point )
+    {
+        type * pX = x.data(); type * pY = y.data(); type * pZ = z.data();
+
+        for( size_t i = 0; i < size(); ++i )
+        {
+            pX[i] += point.x;
+            pY[i] += point.y;
+            pZ[i] += point.z;
+        }
+
+    }   // Add
+
+    /************************************************************************
+    *    desc:  Add a scaled array. ie pos += vel * time
+    ************************************************************************/
+    void AddScaled( const CPointArray & obj, type value )
+    {
+        type * pX = x.data(); type * pY = y.data(); type * pZ = z.data();
+        const type * pObjX = obj.x.data(); const type * pObjY = obj.y.data(); const type * pObjZ = obj.z.data();
+
+        for( size_t i = 0; i < size(); ++i )
+        {
+            pX[i] += pObjX[i] * value;
+            pY[i] += pObjY[i] * value;
+            pZ[i] += pObjZ[i] * value;
+        }
+
+    }   // AddScaled
+
+    /************************************************************************
+    *    desc:  Scale all the points
+    ************************************************************************/
+    void Scale( type value )
+    {
+        type * pX = x.data(); type * pY = y.data(); type * pZ = z.data();
+
+        for( size_t i = 0; i < size(); ++i )
+        {
+            pX[i] *= value;
+            pY[i] *= value;
+            pZ[i] *= value;
+        }
+
+    }   // Scale
+
+    void Scale( const CPoint<type> & scale )
+    {
+        type * pX = x.data(); type * pY = y.data(); type * pZ = z.data();
+
+        for( size_t i = 0; i < size(); ++i )
+        {
+            pX[i] *= scale.x;
+            pY[i] *= scale.y;
+            pZ[i] *= scale.z;
+        }
+
+    }   // Scale
+
+    /************************************************************************
+    *    desc:  Get the dot product of each point with the matching point
+    *           of another array
+    *
+    *    param: type * pDest - size() results
+    ************************************************************************/
+    void GetDotProduct( type * pDest, const CPointArray & obj ) const
+    {
+        const type * pX = x.data(); const type * pY = y.data(); const type * pZ = z.data();
+        const type * pObjX = obj.x.data(); const type * pObjY = obj.y.data(); const type * pObjZ = obj.z.data();
+
+        for( size_t i = 0; i < size(); ++i )
+            pDest[i] = (pX[i] * pObjX[i]) + (pY[i] * pObjY[i]) + (pZ[i] * pObjZ[i]);
+
+    }   // GetDotProduct
+
+    /************************************************************************
+    *    desc:  Get the length of each point
+    *
+    *    param: type * pDest - size() results
+    ************************************************************************/
+    void GetLength( type * pDest ) const
+    {
+        NPointArray::GetLength( pDest, x.data(), y.data(), z.data(), size() );
+
+    }   // GetLength
+
+    /************************************************************************
+    *    desc:  Normalize all the points. Zero length points are left as is.
+    ************************************************************************/
+    void Normalize()
+    {
+        NPointArray::Normalize( x.data(), y.data(), z.data(), size() );
+
+    }   // Normalize
+};
+
+#endif  // __point_array_h__
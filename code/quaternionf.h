@@ -0,0 +1,269 @@
+/************************************************************************
+*    FILE NAME:       quaternionf.h
+*
+*    DESCRIPTION:     Float quaternion class for animation. Unlike
+*                     CQuaternion it doesn't normalize on every set,
+*                     normalizing is left to the caller.
+************************************************************************/
+
+#ifndef __quaternion_f_h__
+#define __quaternion_f_h__
+
+// Game lib dependencies
+#include <common/quaternion.h>
+#include <common/radian.h>
+
+// Standard lib dependencies
+#include <math.h>
+
+// Dot products above this are close enough to use a lerp in the slerp
+const float SLERP_LERP_THRESHOLD = 0.9995f;
+
+class CQuaternionF
+{
+public:
+
+    // Quaternion values
+    float x, y, z, w;
+
+    /************************************************************************
+    *    desc:  Constructor
+    ************************************************************************/
+    CQuaternionF() : x(0), y(0), z(0), w(1)
+    {
+    }   // Constructor
+
+    CQuaternionF( float _x, float _y, float _z, float _w ) : x(_x), y(_y), z(_z), w(_w)
+    {
+    }   // Constructor
+
+    explicit CQuaternionF( const CQuaternion & quat ) :
+        x(quat.x), y(quat.y), z(quat.z), w(quat.w)
+    {
+    }   // Constructor
+
+    /************************************************************************
+    *    desc:  Set to it's identity
+    ************************************************************************/
+    void Identity()
+    {
+        x = 0;
+        y = 0;
+        z = 0;
+        w = 1;
+
+    }   // Identity
+
+    /************************************************************************
+    *    desc:  Set the quaternion data. Not normalized.
+    ************************************************************************/
+    void Set( float _x, float _y, float _z, float _w )
+    {
+        x = _x;
+        y = _y;
+        z = _z;
+        w = _w;
+
+    }   // Set
+
+    /************************************************************************
+    *    desc:  Set a rotation - Assuming the angles are in radians. Same
+    *           result as CQuaternion::SetRotation.
+    ************************************************************************/
+    void SetRotation( const CRadian & radian )
+    {
+        const float p = radian.x * 0.5f;
+        const float h = radian.y * 0.5f;
+        const float r = radian.z * 0.5f;
+
+        const float sinp = sin(p);
+        const float siny = sin(h);
+        const float sinr = sin(r);
+        const float cosp = cos(p);
+        const float cosy = cos(h);
+        const float cosr = cos(r);
+
+        x = sinr * cosp * cosy - cosr * sinp * siny;
+        y = cosr * sinp * cosy + sinr * cosp * siny;
+        z = cosr * cosp * siny - sinr * sinp * cosy;
+        w = cosr * cosp * cosy + sinr * sinp * siny;
+
+    }   // SetRotation
+
+    /************************************************************************
+    *    desc:  The multiplication operator. Same order as CQuaternion.
+    ************************************************************************/
+    CQuaternionF operator * ( const CQuaternionF & quat ) const
+    {
+        return CQuaternionF(
+            (w * quat.x) + (x * quat.w) + (y * quat.z) - (z * quat.y),
+            (w * quat.y) + (y * quat.w) + (z * quat.x) - (x * quat.z),
+            (w * quat.z) + (x * quat.y) - (y * quat.x) + (z * quat.w),
+            (w * quat.w) - (x * quat.x) - (y * quat.y) - (z * quat.z) );
+
+    }   // operator *
+
+    CQuaternionF & operator *= ( const CQuaternionF & quat )
+    {
+        *this = *this * quat;
+
+        return *this;
+
+    }   // operator *=
+
+    /************************************************************************
+    *    desc:  Get the conjugate of this quaternion
+    ************************************************************************/
+    CQuaternionF GetConjugate() const
+    {
+        return CQuaternionF( -x, -y, -z, w );
+
+    }   // GetConjugate
+
+    /************************************************************************
+    *    desc:  Get the dot product
+    ************************************************************************/
+    float GetDotProduct( const CQuaternionF & quat ) const
+    {
+        return (x * quat.x) + (y * quat.y) + (z * quat.z) + (w * quat.w);
+
+    }   // GetDotProduct
+
+    /************************************************************************
+    *    desc:  Get the length squared
+    ************************************************************************/
+    float GetLengthSquared() const
+    {
+        return GetDotProduct( *this );
+
+    }   // GetLengthSquared
+
+    /************************************************************************
+    *    desc:  Normalize this quaternion
+    ************************************************************************/
+    void Normalize()
+    {
+        const float lengthSq = GetLengthSquared();
+
+        if( lengthSq > 0.0f )
+        {
+            const float invLength = 1.0f / sqrt( lengthSq );
+
+            x *= invLength;
+            y *= invLength;
+            z *= invLength;
+            w *= invLength;
+        }
+
+    }   // Normalize
+
+    /************************************************************************
+    *    desc:  Normalized lerp along the shortest path
+    *
+    *    param: const CQuaternionF & a - start rotation
+    *           const CQuaternionF & b - end rotation
+    *           float t - 0 to 1 amount
+    ************************************************************************/
+    static CQuaternionF Nlerp( const CQuaternionF & a, const CQuaternionF & b, float t )
+    {
+        const float sign = (a.GetDotProduct( b ) < 0.0f) ? -1.0f : 1.0f;
+
+        CQuaternionF tmp(
+            a.x + (((b.x * sign) - a.x) * t),
+            a.y + (((b.y * sign) - a.y) * t),
+            a.z + (((b.z * sign) - a.z) * t),
+            a.w + (((b.w * sign) - a.w) * t) );
+
+        tmp.Normalize();
+
+        return tmp;
+
+    }   // Nlerp
+
+    /************************************************************************
+    *    desc:  Spherical lerp along the shortest path. Drops to a lerp
+    *           when the rotations are nearly the same.
+    *
+    *    param: const CQuaternionF & a - start rotation
+    *           const CQuaternionF & b - end rotation
+    *           float t - 0 to 1 amount
+    ************************************************************************/
+    static CQuaternionF Slerp( const CQuaternionF & a, const CQuaternionF & b, float t )
+    {
+        float dot = a.GetDotProduct( b );
+        float sign = 1.0f;
+
+        if( dot < 0.0f )
+        {
+            dot = -dot;
+            sign = -1.0f;
+        }
+
+        float weightA = 1.0f - t;
+        float weightB = t;
+
+        if( dot < SLERP_LERP_THRESHOLD )
+        {
+            const float theta = acos( dot );
+            const float invSinTheta = 1.0f / sqrt( 1.0f - (dot * dot) );
+
+            weightA = sin( weightA * theta ) * invSinTheta;
+            weightB = sin( weightB * theta ) * invSinTheta;
+        }
+
+        weightB *= sign;
+
+        CQuaternionF tmp(
+            (a.x * weightA) + (b.x * weightB),
+            (a.y * weightA) + (b.y * weightB),
+            (a.z * weightA) + (b.z * weightB),
+            (a.w * weightA) + (b.w * weightB) );
+
+        tmp.Normalize();
+
+        return tmp;
+
+    }   // Slerp
+
+    /************************************************************************
+    *    desc:  Get the rotation matrix. Same result as CMatrix::Set on an
+    *           identity matrix.
+    *
+    *    param:  float dest[16] - destination matrix array
+    ************************************************************************/
+    void GetMatrix( float dest[16] ) const
+    {
+        const float x2 = x * x;
+        const float y2 = y * y;
+        const float z2 = z * z;
+        const float xy = x * y;
+        const float xz = x * z;
+        const float yz = y * z;
+        const float wx = w * x;
+        const float wy = w * y;
+        const float wz = w * z;
+
+        dest[0]  = 1.0f - 2.0f * (y2 + z2);
+        dest[1]  = 2.0f * (xy - wz);
+        dest[2]  = 2.0f * (xz + wy);
+        dest[3]  = 0.0f;
+
+        dest[4]  = 2.0f * (xy + wz);
+        dest[5]  = 1.0f - 2.0f * (x2 + z2);
+        dest[6]  = 2.0f * (yz - wx);
+        dest[7]  = 0.0f;
+
+        dest[8]  = 2.0f * (xz - wy);
+        dest[9]  = 2.0f * (yz + wx);
+        dest[10] = 1.0f - 2.0f * (x2 + y2);
+        dest[11] = 0.0f;
+
+        dest[12] = 0.0f;
+        dest[13] = 0.0f;
+        dest[14] = 0.0f;
+        dest[15] = 1.0f;
+
+    }   // GetMatrix
+};
+
+#endif  // __quaternion_f_h__
@@ -0,0 +1,451 @@
+/************************************************************************
+*    FILE NAME:       quaternionsimd.cpp
+*
+*    DESCRIPTION:     Batch quaternion functions over SoA arrays for
+*                     blending animation joints. Uses the SSE2 kernels
+*                     when NMatrixSimd has selected a SIMD kernel.
+************************************************************************/
+
+// Physical component dependency
+#include <common/quaternionsimd.h>
+
+// Game lib dependencies
+#include <common/quaternionf.h>
+#include <common/matrixsimd.h>
+
+// Standard lib dependencies
+#include <math.h>
+
+#if defined(MATRIX_SIMD_X86)
+    #include <emmintrin.h>
+#endif
+
+#if defined(MATRIX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define QUAT_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+    #define QUAT_TARGET_SSE2
+#endif
+
+namespace NQuatSimd
+{
+    /************************************************************************
+    *    desc:  Get/put one quaternion from the SoA arrays
+    ************************************************************************/
+    static inline CQuaternionF Get( const CQuatSoA & soa, int i )
+    {
+        return CQuaternionF( soa.x[i], soa.y[i], soa.z[i], soa.w[i] );
+
+    }   // Get
+
+    static inline void Put( const CQuatSoA & soa, int i, const CQuaternionF & quat )
+    {
+        soa.x[i] = quat.x;
+        soa.y[i] = quat.y;
+        soa.z[i] = quat.z;
+        soa.w[i] = quat.w;
+
+    }   // Put
+
+    /************************************************************************
+    *    desc:  Should the SSE2 kernels be used
+    ************************************************************************/
+    static inline bool UseSSE2()
+    {
+        #if defined(MATRIX_SIMD_X86)
+        return (NMatrixSimd::GetKernel() != NMatrixSimd::EK_SCALAR);
+        #else
+        return false;
+        #endif
+
+    }   // UseSSE2
+
+    #if defined(MATRIX_SIMD_X86)
+
+    /************************************************************************
+    *    desc:  Four quaternions in SSE2 registers
+    ************************************************************************/
+    class CQuat4
+    {
+    public:
+        __m128 x, y, z, w;
+    };
+
+    QUAT_TARGET_SSE2
+    static inline CQuat4 Load4( const CQuatSoA & soa, int i )
+    {
+        CQuat4 tmp;
+        tmp.x = _mm_loadu_ps( soa.x + i );
+        tmp.y = _mm_loadu_ps( soa.y + i );
+        tmp.z = _mm_loadu_ps( soa.z + i );
+        tmp.w = _mm_loadu_ps( soa.w + i );
+
+        return tmp;
+
+    }   // Load4
+
+    QUAT_TARGET_SSE2
+    static inline void Store4( const CQuatSoA & soa, int i, const CQuat4 & quat )
+    {
+        _mm_storeu_ps( soa.x + i, quat.x );
+        _mm_storeu_ps( soa.y + i, quat.y );
+        _mm_storeu_ps( soa.z + i, quat.z );
+        _mm_storeu_ps( soa.w + i, quat.w );
+
+    }   // Store4
+
+    QUAT_TARGET_SSE2
+    static inline __m128 Dot4( const CQuat4 & a, const CQuat4 & b )
+    {
+        return _mm_add_ps(
+            _mm_add_ps( _mm_mul_ps( a.x, b.x ), _mm_mul_ps( a.y, b.y ) ),
+            _mm_add_ps( _mm_mul_ps( a.z, b.z ), _mm_mul_ps( a.w, b.w ) ) );
+
+    }   // Dot4
+
+    /************************************************************************
+    *    desc:  Normalize four quaternions. Zero lengths are left as is.
+    ************************************************************************/
+    QUAT_TARGET_SSE2
+    static inline void Normalize4( CQuat4 & quat )
+    {
+        const __m128 lengthSq = Dot4( quat, quat );
+        const __m128 nonZero = _mm_cmpgt_ps( lengthSq, _mm_setzero_ps() );
+        const __m128 one = _mm_set1_ps( 1.0f );
+
+        // Zero lengths divide 1 by 1 so there are no infinities to mask off
+        __m128 invLength = _mm_div_ps( one, _mm_sqrt_ps( _mm_or_ps( _mm_and_ps( nonZero, lengthSq ), _mm_andnot_ps( nonZero, one ) ) ) );
+
+        quat.x = _mm_mul_ps( quat.x, invLength );
+        quat.y = _mm_mul_ps( quat.y, invLength );
+        quat.z = _mm_mul_ps( quat.z, invLength );
+        quat.w = _mm_mul_ps( quat.w, invLength );
+
+    }   // Normalize4
+
+    /************************************************************************
+    *    desc:  Flip b to the same hemisphere as a. Returns the dot product
+    *           after the flip, which is never negative.
+    ************************************************************************/
+    QUAT_TARGET_SSE2
+    static inline __m128 ShortestPath4( const CQuat4 & a, CQuat4 & b )
+    {
+        const __m128 dot = Dot4( a, b );
+        const __m128 signBit = _mm_and_ps( dot, _mm_set1_ps( -0.0f ) );
+
+        b.x = _mm_xor_ps( b.x, signBit );
+        b.y = _mm_xor_ps( b.y, signBit );
+        b.z = _mm_xor_ps( b.z, signBit );
+        b.w = _mm_xor_ps( b.w, signBit );
+
+        return _mm_xor_ps( dot, signBit );
+
+    }   // ShortestPath4
+
+    /************************************************************************
+    *    desc:  sin for 0 to pi/2. Taylor series to x^11, max error 6e-8
+    ************************************************************************/
+    QUAT_TARGET_SSE2
+    static inline __m128 Sin4( __m128 x )
+    {
+        const __m128 x2 = _mm_mul_ps( x, x );
+
+        __m128 result = _mm_set1_ps( -1.0f / 39916800.0f );
+        result = _mm_add_ps( _mm_mul_ps( result, x2 ), _mm_set1_ps( 1.0f / 362880.0f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x2 ), _mm_set1_ps( -1.0f / 5040.0f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x2 ), _mm_set1_ps( 1.0f / 120.0f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x2 ), _mm_set1_ps( -1.0f / 6.0f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x2 ), _mm_set1_ps( 1.0f ) );
+
+        return _mm_mul_ps( result, x );
+
+    }   // Sin4
+
+    /************************************************************************
+    *    desc:  acos for 0 to 1. Abramowitz & Stegun 4.4.46, max error 2e-8
+    ************************************************************************/
+    QUAT_TARGET_SSE2
+    static inline __m128 Acos4( __m128 x )
+    {
+        __m128 result = _mm_set1_ps( -0.0012624911f );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( 0.0066700901f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( -0.0170881256f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( 0.0308918810f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( -0.0501743046f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( 0.0889789874f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( -0.2145988016f ) );
+        result = _mm_add_ps( _mm_mul_ps( result, x ), _mm_set1_ps( 1.5707963050f ) );
+
+        return _mm_mul_ps( result, _mm_sqrt_ps( _mm_sub_ps( _mm_set1_ps( 1.0f ), x ) ) );
+
+    }   // Acos4
+
+    /************************************************************************
+    *    desc:  SSE2 kernels. Each does as many blocks of four as it can
+    *           and returns the number done. The remainder is scalar.
+    ************************************************************************/
+    QUAT_TARGET_SSE2
+    static int MultiplySSE2( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, int count )
+    {
+        const int blockCount = count & ~3;
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const CQuat4 qa = Load4( a, i );
+            const CQuat4 qb = Load4( b, i );
+            CQuat4 result;
+
+            result.x = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( qa.w, qb.x ), _mm_mul_ps( qa.x, qb.w ) ), _mm_mul_ps( qa.y, qb.z ) ), _mm_mul_ps( qa.z, qb.y ) );
+            result.y = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( qa.w, qb.y ), _mm_mul_ps( qa.y, qb.w ) ), _mm_mul_ps( qa.z, qb.x ) ), _mm_mul_ps( qa.x, qb.z ) );
+            result.z = _mm_add_ps( _mm_sub_ps( _mm_add_ps( _mm_mul_ps( qa.w, qb.z ), _mm_mul_ps( qa.x, qb.y ) ), _mm_mul_ps( qa.y, qb.x ) ), _mm_mul_ps( qa.z, qb.w ) );
+            result.w = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( _mm_mul_ps( qa.w, qb.w ), _mm_mul_ps( qa.x, qb.x ) ), _mm_mul_ps( qa.y, qb.y ) ), _mm_mul_ps( qa.z, qb.z ) );
+
+            Store4( dest, i, result );
+        }
+
+        return blockCount;
+
+    }   // MultiplySSE2
+
+    QUAT_TARGET_SSE2
+    static int NormalizeSSE2( const CQuatSoA & dest, const CQuatSoA & source, int count )
+    {
+        const int blockCount = count & ~3;
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            CQuat4 quat = Load4( source, i );
+            Normalize4( quat );
+            Store4( dest, i, quat );
+        }
+
+        return blockCount;
+
+    }   // NormalizeSSE2
+
+    QUAT_TARGET_SSE2
+    static int NlerpSSE2( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, const float * pT, int count )
+    {
+        const int blockCount = count & ~3;
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const CQuat4 qa = Load4( a, i );
+            CQuat4 qb = Load4( b, i );
+            const __m128 t = _mm_loadu_ps( pT + i );
+
+            ShortestPath4( qa, qb );
+
+            CQuat4 result;
+            result.x = _mm_add_ps( qa.x, _mm_mul_ps( _mm_sub_ps( qb.x, qa.x ), t ) );
+            result.y = _mm_add_ps( qa.y, _mm_mul_ps( _mm_sub_ps( qb.y, qa.y ), t ) );
+            result.z = _mm_add_ps( qa.z, _mm_mul_ps( _mm_sub_ps( qb.z, qa.z ), t ) );
+            result.w = _mm_add_ps( qa.w, _mm_mul_ps( _mm_sub_ps( qb.w, qa.w ), t ) );
+
+            Normalize4( result );
+            Store4( dest, i, result );
+        }
+
+        return blockCount;
+
+    }   // NlerpSSE2
+
+    QUAT_TARGET_SSE2
+    static int SlerpSSE2( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, const float * pT, int count )
+    {
+        const int blockCount = count & ~3;
+        const __m128 one = _mm_set1_ps( 1.0f );
+        const __m128 threshold = _mm_set1_ps( SLERP_LERP_THRESHOLD );
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const CQuat4 qa = Load4( a, i );
+            CQuat4 qb = Load4( b, i );
+            const __m128 t = _mm_loadu_ps( pT + i );
+
+            const __m128 dot = ShortestPath4( qa, qb );
+
+            // Lerp weights
+            const __m128 oneMinusT = _mm_sub_ps( one, t );
+
+            // Slerp weights. Lanes over the threshold compute garbage
+            // here but are replaced by the lerp weights below.
+            const __m128 useSlerp = _mm_cmplt_ps( dot, threshold );
+            const __m128 safeDot = _mm_and_ps( useSlerp, dot );
+            const __m128 theta = Acos4( safeDot );
+            const __m128 invSinTheta = _mm_div_ps( one, _mm_sqrt_ps( _mm_sub_ps( one, _mm_mul_ps( safeDot, safeDot ) ) ) );
+            const __m128 slerpA = _mm_mul_ps( Sin4( _mm_mul_ps( oneMinusT, theta ) ), invSinTheta );
+            const __m128 slerpB = _mm_mul_ps( Sin4( _mm_mul_ps( t, theta ) ), invSinTheta );
+
+            const __m128 weightA = _mm_or_ps( _mm_and_ps( useSlerp, slerpA ), _mm_andnot_ps( useSlerp, oneMinusT ) );
+            const __m128 weightB = _mm_or_ps( _mm_and_ps( useSlerp, slerpB ), _mm_andnot_ps( useSlerp, t ) );
+
+            CQuat4 result;
+            result.x = _mm_add_ps( _mm_mul_ps( qa.x, weightA ), _mm_mul_ps( qb.x, weightB ) );
+            result.y = _mm_add_ps( _mm_mul_ps( qa.y, weightA ), _mm_mul_ps( qb.y, weightB ) );
+            result.z = _mm_add_ps( _mm_mul_ps( qa.z, weightA ), _mm_mul_ps( qb.z, weightB ) );
+            result.w = _mm_add_ps( _mm_mul_ps( qa.w, weightA ), _mm_mul_ps( qb.w, weightB ) );
+
+            Normalize4( result );
+            Store4( dest, i, result );
+        }
+
+        return blockCount;
+
+    }   // SlerpSSE2
+
+    QUAT_TARGET_SSE2
+    static int ToMatrixSSE2( float * pDest, const CQuatSoA & source, int count )
+    {
+        const int blockCount = count & ~3;
+        const __m128 one = _mm_set1_ps( 1.0f );
+        const __m128 two = _mm_set1_ps( 2.0f );
+        const __m128 row3 = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const CQuat4 q = Load4( source, i );
+
+            const __m128 x2 = _mm_mul_ps( q.x, q.x );
+            const __m128 y2 = _mm_mul_ps( q.y, q.y );
+            const __m128 z2 = _mm_mul_ps( q.z, q.z );
+            const __m128 xy = _mm_mul_ps( q.x, q.y );
+            const __m128 xz = _mm_mul_ps( q.x, q.z );
+            const __m128 yz = _mm_mul_ps( q.y, q.z );
+            const __m128 wx = _mm_mul_ps( q.w, q.x );
+            const __m128 wy = _mm_mul_ps( q.w, q.y );
+            const __m128 wz = _mm_mul_ps( q.w, q.z );
+
+            __m128 row0[4], row1[4], row2[4];
+
+            row0[0] = _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( y2, z2 ) ) );
+            row0[1] = _mm_mul_ps( two, _mm_sub_ps( xy, wz ) );
+            row0[2] = _mm_mul_ps( two, _mm_add_ps( xz, wy ) );
+            row0[3] = _mm_setzero_ps();
+
+            row1[0] = _mm_mul_ps( two, _mm_add_ps( xy, wz ) );
+            row1[1] = _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( x2, z2 ) ) );
+            row1[2] = _mm_mul_ps( two, _mm_sub_ps( yz, wx ) );
+            row1[3] = _mm_setzero_ps();
+
+            row2[0] = _mm_mul_ps( two, _mm_sub_ps( xz, wy ) );
+            row2[1] = _mm_mul_ps( two, _mm_add_ps( yz, wx ) );
+            row2[2] = _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( x2, y2 ) ) );
+            row2[3] = _mm_setzero_ps();
+
+            // Each register holds one element for four matrices. Transpose
+            // so each register holds one row of one matrix.
+            _MM_TRANSPOSE4_PS( row0[0], row0[1], row0[2], row0[3] );
+            _MM_TRANSPOSE4_PS( row1[0], row1[1], row1[2], row1[3] );
+            _MM_TRANSPOSE4_PS( row2[0], row2[1], row2[2], row2[3] );
+
+            for( int j = 0; j < 4; ++j )
+            {
+                float * pMat = pDest + ((i + j) * 16);
+
+                _mm_storeu_ps( pMat,      row0[j] );
+                _mm_storeu_ps( pMat + 4,  row1[j] );
+                _mm_storeu_ps( pMat + 8,  row2[j] );
+                _mm_storeu_ps( pMat + 12, row3 );
+            }
+        }
+
+        return blockCount;
+
+    }   // ToMatrixSSE2
+
+    #endif  // MATRIX_SIMD_X86
+
+
+    /************************************************************************
+    *    desc:  dest = a * b in the same order as CQuaternion
+    ************************************************************************/
+    void Multiply( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, int count )
+    {
+        int i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( UseSSE2() )
+            i = MultiplySSE2( dest, a, b, count );
+        #endif
+
+        for( ; i < count; ++i )
+            Put( dest, i, Get( a, i ) * Get( b, i ) );
+
+    }   // Multiply
+
+
+    /************************************************************************
+    *    desc:  Normalize. Zero length quaternions are left as is.
+    ************************************************************************/
+    void Normalize( const CQuatSoA & dest, const CQuatSoA & source, int count )
+    {
+        int i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( UseSSE2() )
+            i = NormalizeSSE2( dest, source, count );
+        #endif
+
+        for( ; i < count; ++i )
+        {
+            CQuaternionF quat = Get( source, i );
+            quat.Normalize();
+            Put( dest, i, quat );
+        }
+
+    }   // Normalize
+
+
+    /************************************************************************
+    *    desc:  Normalized lerp along the shortest path
+    ************************************************************************/
+    void Nlerp( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, const float * pT, int count )
+    {
+        int i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( UseSSE2() )
+            i = NlerpSSE2( dest, a, b, pT, count );
+        #endif
+
+        for( ; i < count; ++i )
+            Put( dest, i, CQuaternionF::Nlerp( Get( a, i ), Get( b, i ), pT[i] ) );
+
+    }   // Nlerp
+
+
+    /************************************************************************
+    *    desc:  Spherical lerp along the shortest path
+    ************************************************************************/
+    void Slerp( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, const float * pT, int count )
+    {
+        int i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( UseSSE2() )
+            i = SlerpSSE2( dest, a, b, pT, count );
+        #endif
+
+        for( ; i < count; ++i )
+            Put( dest, i, CQuaternionF::Slerp( Get( a, i ), Get( b, i ), pT[i] ) );
+
+    }   // Slerp
+
+
+    /************************************************************************
+    *    desc:  Convert to rotation matrices
+    ************************************************************************/
+    void ToMatrix( float * pDest, const CQuatSoA & source, int count )
+    {
+        int i = 0;
+
+        #if defined(MATRIX_SIMD_X86)
+        if( UseSSE2() )
+            i = ToMatrixSSE2( pDest, source, count );
+        #endif
+
+        for( ; i < count; ++i )
+            Get( source, i ).GetMatrix( pDest + (i * 16) );
+
+    }   // ToMatrix
+}
@@ -0,0 +1,55 @@
+/************************************************************************
+*    FILE NAME:       quaternionsimd.h
+*
+*    DESCRIPTION:     Batch quaternion functions over SoA arrays for
+*                     blending animation joints. Uses the SSE2 kernels
+*                     when NMatrixSimd has selected a SIMD kernel.
+************************************************************************/
+
+#ifndef __quaternion_simd_h__
+#define __quaternion_simd_h__
+
+// Separate x, y, z and w arrays. Does not own the memory.
+class CQuatSoA
+{
+public:
+
+    float * x;
+    float * y;
+    float * z;
+    float * w;
+
+    CQuatSoA() : x(nullptr), y(nullptr), z(nullptr), w(nullptr)
+    {
+    }
+
+    CQuatSoA( float * _x, float * _y, float * _z, float * _w ) : x(_x), y(_y), z(_z), w(_w)
+    {
+    }
+};
+
+namespace NQuatSimd
+{
+    // NOTE: In all of the functions the destination is allowed to be
+    //       the same memory as one of the sources.
+
+    // dest = a * b in the same order as CQuaternion
+    void Multiply( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, int count );
+
+    // Normalize. Zero length quaternions are left as is.
+    void Normalize( const CQuatSoA & dest, const CQuatSoA & source, int count );
+
+    // Normalized lerp along the shortest path. One t per quaternion.
+    void Nlerp( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, const float * pT, int count );
+
+    // Spherical lerp along the shortest path. One t per quaternion.
+    // The SIMD kernel uses polynomial acos and sin and is within 1e-6
+    // of the scalar result.
+    void Slerp( const CQuatSoA & dest, const CQuatSoA & a, const CQuatSoA & b, const float * pT, int count );
+
+    // Convert to rotation matrices. pDest is count * 16 floats in
+    // the same layout as CMatrix::Set( CQuaternion )
+    void ToMatrix( float * pDest, const CQuatSoA & source, int count );
+}
+
+#endif  // __quaternion_simd_h__
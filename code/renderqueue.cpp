@@ -0,0 +1,250 @@
+/************************************************************************
+*    FILE NAME:       renderqueue.cpp
+*
+*    DESCRIPTION:     Queue of render commands sorted by a 64-bit key so
+*                     the draws of a frame are submitted with the fewest
+*                     state changes.
+************************************************************************/
+
+// Physical component dependency
+#include <2d/renderqueue.h>
+
+// Game lib dependencies
+#include <2d/visualcomponent2d.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+namespace
+{
+    const int LAYER_SHIFT = 56;
+    const int SHADER_SHIFT = 44;
+    const int TEXTURE_SHIFT = 28;
+    const int VBO_SHIFT = 12;
+
+    const uint64_t SHADER_MASK = 0xFFF;
+    const uint64_t TEXTURE_MASK = 0xFFFF;
+    const uint64_t VBO_MASK = 0xFFFF;
+    const uint64_t DEPTH_MAX = 0xFFF;
+}
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CRenderQueue::CRenderQueue() :
+    m_transparentVec( MAX_LAYERS, false ),
+    m_sequence(0)
+{
+}   // constructor
+
+
+/************************************************************************
+*    desc:  Flag a layer as transparent so it keeps the add order
+************************************************************************/
+void CRenderQueue::SetTransparentLayer( uint layer, bool transparent )
+{
+    m_transparentVec.at( layer ) = transparent;
+
+}   // SetTransparentLayer
+
+bool CRenderQueue::IsTransparentLayer( uint layer ) const
+{
+    return m_transparentVec.at( layer );
+
+}   // IsTransparentLayer
+
+
+/************************************************************************
+*    desc:  Build the sort key for a command. The IDs are masked to fit
+*           so two IDs can share a value. That only costs a state change.
+************************************************************************/
+uint64_t CRenderQueue::MakeKey( uint layer, uint shaderID, uint textureID, uint vboID, float depth )
+{
+    uint64_t key = (uint64_t)(layer & 0xFF) << LAYER_SHIFT;
+
+    // Transparent layers sort on the add order only
+    if( m_transparentVec[layer & 0xFF] )
+        return key | m_sequence++;
+
+    if( depth < 0.f )
+        depth = 0.f;
+    else if( depth > 1.f )
+        depth = 1.f;
+
+    key |= (shaderID & SHADER_MASK) << SHADER_SHIFT;
+    key |= (textureID & TEXTURE_MASK) << TEXTURE_SHIFT;
+    key |= (vboID & VBO_MASK) << VBO_SHIFT;
+    key |= (uint64_t)(depth * DEPTH_MAX);
+
+    return key;
+
+}   // MakeKey
+
+
+/************************************************************************
+*    desc:  Add a command
+*
+*    param: CVisualComponent2d * pVisual - visual to render
+*           const float * pFinalMatrix - matrix to render it with
+*           uint layer - layer, rendered lowest to highest
+*           uint shaderID, textureID, vboID - GL state of the draw
+*           float depth - 0 to 1, front to back
+************************************************************************/
+void CRenderQueue::Add(
+    CVisualComponent2d * pVisual,
+    const float * pFinalMatrix,
+    uint layer, uint shaderID, uint textureID, uint vboID, float depth )
+{
+    m_commandVec.emplace_back();
+    CRenderCommand & rCommand = m_commandVec.back();
+
+    rCommand.key = MakeKey( layer, shaderID, textureID, vboID, depth );
+    rCommand.layer = layer;
+    rCommand.shaderID = shaderID;
+    rCommand.textureID = textureID;
+    rCommand.vboID = vboID;
+    rCommand.pVisual = pVisual;
+    std::memcpy( rCommand.matrix, pFinalMatrix, sizeof(rCommand.matrix) );
+
+    m_orderVec.push_back( m_commandVec.size() - 1 );
+
+}   // Add
+
+
+/************************************************************************
+*    desc:  Sort the commands by key with an LSD radix sort on the order
+*           indices. The sort is stable so equal keys keep their order.
+*           Passes where every key has the same byte are skipped, which
+*           is most of them when there are only a few layers.
+************************************************************************/
+void CRenderQueue::Sort()
+{
+    const size_t count = m_orderVec.size();
+
+    if( count < 2 )
+        return;
+
+    m_tmpOrderVec.resize( count );
+
+    for( int shift = 0; shift < 64; shift += 8 )
+    {
+        size_t histogram[256] = {0};
+
+        for( size_t i = 0; i < count; ++i )
+            ++histogram[(m_commandVec[m_orderVec[i]].key >> shift) & 0xFF];
+
+        // Skip the pass if all the keys land in one bucket
+        if( histogram[(m_commandVec[m_orderVec[0]].key >> shift) & 0xFF] == count )
+            continue;
+
+        // Turn the counts into offsets
+        size_t offset = 0;
+        for( int i = 0; i < 256; ++i )
+        {
+            const size_t tmp = histogram[i];
+            histogram[i] = offset;
+            offset += tmp;
+        }
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            const uint index = m_orderVec[i];
+            m_tmpOrderVec[histogram[(m_commandVec[index].key >> shift) & 0xFF]++] = index;
+        }
+
+        m_orderVec.swap( m_tmpOrderVec );
+    }
+
+}   // Sort
+
+
+/************************************************************************
+*    desc:  Render the commands in their current order
+************************************************************************/
+void CRenderQueue::Submit()
+{
+    for( auto index : m_orderVec )
+    {
+        const CRenderCommand & rCommand = m_commandVec[index];
+        rCommand.pVisual->DrawElements( rCommand.matrix );
+    }
+
+}   // Submit
+
+
+/************************************************************************
+*    desc:  Clear the commands for the next frame
+************************************************************************/
+void CRenderQueue::Clear()
+{
+    m_commandVec.clear();
+    m_orderVec.clear();
+    m_sequence = 0;
+
+}   // Clear
+
+
+/************************************************************************
+*    desc:  Sort, submit and clear
+************************************************************************/
+void CRenderQueue::Flush()
+{
+    Sort();
+    Submit();
+    Clear();
+
+}   // Flush
+
+
+/************************************************************************
+*    desc:  Access to the commands in their current order
+************************************************************************/
+size_t CRenderQueue::GetCommandCount() const
+{
+    return m_orderVec.size();
+
+}   // GetCommandCount
+
+const CRenderCommand & CRenderQueue::GetCommand( size_t index ) const
+{
+    return m_commandVec[m_orderVec.at( index )];
+
+}   // GetCommand
+
+
+/************************************************************************
+*    desc:  Number of changes in shader, texture or vbo between the
+*           commands in their current order
+************************************************************************/
+int CRenderQueue::GetStateChangeCount() const
+{
+    int changeCount = 0;
+
+    for( size_t i = 1; i < m_orderVec.size(); ++i )
+    {
+        const CRenderCommand & rLast = m_commandVec[m_orderVec[i-1]];
+        const CRenderCommand & rCommand = m_commandVec[m_orderVec[i]];
+
+        if( rLast.shaderID != rCommand.shaderID )
+            ++changeCount;
+
+        if( rLast.textureID != rCommand.textureID )
+            ++changeCount;
+
+        if( rLast.vboID != rCommand.vboID )
+            ++changeCount;
+    }
+
+    return changeCount;
+
+}   // GetStateChangeCount
+
+
+/************************************************************************
+*    desc:  Get the layer from a key
+************************************************************************/
+uint CRenderQueue::GetLayer( uint64_t key )
+{
+    return (uint)(key >> LAYER_SHIFT);
+
+}   // GetLayer
@@ -0,0 +1,112 @@
+/************************************************************************
+*    FILE NAME:       renderqueue.h
+*
+*    DESCRIPTION:     Queue of render commands sorted by a 64-bit key so
+*                     the draws of a frame are submitted with the fewest
+*                     state changes. Layers flagged as transparent keep
+*                     the order the commands were added in.
+*
+*                     Opaque key layout (high to low bits)
+*                       layer 8 | shader 12 | texture 16 | vbo 16 | depth 12
+*
+*                     Transparent key layout
+*                       layer 8 | unused 24 | sequence 32
+************************************************************************/
+
+#ifndef __render_queue_h__
+#define __render_queue_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Forward declaration(s)
+class CVisualComponent2d;
+
+class CRenderCommand
+{
+public:
+
+    // Sort key
+    uint64_t key;
+
+    // The state the key was built from
+    uint layer;
+    uint shaderID;
+    uint textureID;
+    uint vboID;
+
+    // The visual to render and it's final matrix
+    CVisualComponent2d * pVisual;
+    float matrix[16];
+};
+
+class CRenderQueue
+{
+public:
+
+    // Max number of layers
+    static const int MAX_LAYERS = 256;
+
+    // Constructor
+    CRenderQueue();
+
+    // Flag a layer as transparent so it keeps the add order
+    void SetTransparentLayer( uint layer, bool transparent = true );
+    bool IsTransparentLayer( uint layer ) const;
+
+    // Add a command. Depth is 0 to 1, front to back.
+    void Add(
+        CVisualComponent2d * pVisual,
+        const float * pFinalMatrix,
+        uint layer, uint shaderID, uint textureID, uint vboID, float depth );
+
+    // Sort the commands by key. Commands with the same key keep their order.
+    void Sort();
+
+    // Render the commands in their current order
+    void Submit();
+
+    // Clear the commands for the next frame
+    void Clear();
+
+    // Sort, submit and clear
+    void Flush();
+
+    // Access to the commands for inspecting the queue
+    size_t GetCommandCount() const;
+    const CRenderCommand & GetCommand( size_t index ) const;
+
+    // Number of changes in shader, texture or vbo between the
+    // commands in their current order
+    int GetStateChangeCount() const;
+
+    // Get the layer from a key
+    static uint GetLayer( uint64_t key );
+
+private:
+
+    // Build the sort key for a command
+    uint64_t MakeKey( uint layer, uint shaderID, uint textureID, uint vboID, float depth );
+
+private:
+
+    // The commands and the order to submit them in
+    std::vector<CRenderCommand> m_commandVec;
+    std::vector<uint> m_orderVec;
+
+    // Scratch space for the radix sort
+    std::vector<uint> m_tmpOrderVec;
+
+    // Transparent layer flags
+    std::vector<bool> m_transparentVec;
+
+    // Add order of the transparent commands
+    uint m_sequence;
+};
+
+#endif  // __render_queue_h__
@@ -12,12 +12,20 @@
 #include <SDL_opengl.h>  // SDL/OpenGL lib dependencies
 #endif
 
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
 // Physical component dependency
 #include <managers/shadermanager.h>
 
 // Game lib dependencies
+#include <managers/glstatemanager.h>
+#include <managers/frameuniformmanager.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
+#include <utilities/statcounter.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -29,7 +37,8 @@
 *    desc:  Constructer
 ************************************************************************/
 CShaderMgr::CShaderMgr()
-    : m_currentProgramID(0)
+    : m_currentProgramID(0),
+      m_pUniformCache(nullptr)
 {
 }   // constructor
 
@@ -109,6 +118,9 @@ void CShaderMgr::CreateShader( const XMLNode & node )
     // Link the shader program
     LinkProgram();
 
+    // Wire the per frame uniform block if the shader uses it
+    CFrameUniformMgr::Instance().BindBlock( m_Iter->second.GetProgramID() );
+
     // Set all the shader attributes
     LocateShaderVariables( vertexNode, fragmentNode );
 
@@ -292,9 +304,20 @@ const CShaderData & CShaderMgr::GetShaderData( const std::string & shaderID )
 }   // GetShaderData
 
 
+/************************************************************************
+*    desc:  Has a shader of this name been loaded
+************************************************************************/
+bool CShaderMgr::IsShader( const std::string & shaderID ) const
+{
+    return (m_shaderMap.find( shaderID ) != m_shaderMap.end());
+
+}   // IsShader
+
+
 /************************************************************************
 *    desc:  Function call used to manage what shader is currently bound.
-*           This insures that we don't keep rebinding the same shader
+*           The GL state manager insures that we don't keep rebinding
+*           the same shader.
 ************************************************************************/
 void CShaderMgr::BindShaderProgram( GLuint programID )
 {
@@ -303,10 +326,12 @@ void CShaderMgr::BindShaderProgram( GLuint programID )
         // save the current binding
         m_currentProgramID = programID;
 
-        // Have OpenGL bind this shader now
-        glUseProgram( programID );
+        // Uniform values belong to the program so switch to it's cache
+        m_pUniformCache = (programID > 0) ? &m_uniformCacheMap[programID] : nullptr;
     }
 
+    CGLStateMgr::Instance().UseProgram( programID );
+
 }   // BindShaderProgram
 
 
@@ -316,11 +341,57 @@ void CShaderMgr::BindShaderProgram( GLuint programID )
 void CShaderMgr::UnbindShaderProgram()
 {
     m_currentProgramID = 0;
-    glUseProgram( 0 );
+    m_pUniformCache = nullptr;
+    CGLStateMgr::Instance().UseProgram( 0 );
 
 }   // UseShaderProgram
 
 
+/************************************************************************
+*    desc:  Has the uniform value changed for the bound program. Counts
+*           the cache hits and misses in the stat counter.
+************************************************************************/
+bool CShaderMgr::IsUniformChanged( GLint location, const void * pValue, size_t size )
+{
+    if( (m_pUniformCache != nullptr) && !m_pUniformCache->IsChanged( location, pValue, size ) )
+    {
+        CStatCounter::Instance().IncUniformCacheHitCounter();
+        return false;
+    }
+
+    CStatCounter::Instance().IncUniformCacheMissCounter();
+
+    return true;
+
+}   // IsUniformChanged
+
+
+/************************************************************************
+*    desc:  Set a uniform of the bound program. The GL call is skipped
+*           if the value is the same as the last one set.
+************************************************************************/
+void CShaderMgr::SetUniform1i( GLint location, GLint value )
+{
+    if( IsUniformChanged( location, &value, sizeof(value) ) )
+        glUniform1i( location, value );
+
+}   // SetUniform1i
+
+void CShaderMgr::SetUniform4fv( GLint location, const GLfloat * pValue )
+{
+    if( IsUniformChanged( location, pValue, sizeof(GLfloat) * 4 ) )
+        glUniform4fv( location, 1, pValue );
+
+}   // SetUniform4fv
+
+void CShaderMgr::SetUniformMatrix4fv( GLint location, const GLfloat * pValue )
+{
+    if( IsUniformChanged( location, pValue, sizeof(GLfloat) * 16 ) )
+        glUniformMatrix4fv( location, 1, GL_FALSE, pValue );
+
+}   // SetUniformMatrix4fv
+
+
 /************************************************************************
 *    desc:  Free the shader
 ************************************************************************/
@@ -330,7 +401,15 @@ void CShaderMgr::FreeShader( const std::string & shaderID )
     m_Iter = m_shaderMap.find( shaderID );
     if( m_Iter != m_shaderMap.end() )
     {
+        // The program ID can be given to a new program so drop it's values
+        const GLuint programID = m_Iter->second.GetProgramID();
+        if( m_currentProgramID == programID )
+            UnbindShaderProgram();
+
+        m_uniformCacheMap.erase( programID );
+
         m_Iter->second.Free();
+        CGLStateMgr::Instance().OnDeleteProgram( programID );
         
         // Erase this group
         m_shaderMap.erase( m_Iter );
@@ -0,0 +1,404 @@
+/************************************************************************
+*    FILE NAME:       spritebatchmanager.cpp
+*
+*    DESCRIPTION:     Collects quads and sprite sheet frames that share
+*                     the same shader, texture and color, transforms them
+*                     on the CPU into one streaming vertex buffer and
+*                     renders each batch with one draw call. Font strings
+*                     are batched the same way.
+************************************************************************/
+
+#if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+// Glew dependencies (have to be defined first)
+#include <GL/glew.h>
+#endif
+
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
+// Physical component dependency
+#include <managers/spritebatchmanager.h>
+
+// Game lib dependencies
+#include <managers/shadermanager.h>
+#include <managers/texturemanager.h>
+#include <managers/vertexbuffermanager.h>
+#include <managers/streambuffermanager.h>
+#include <common/quad2d.h>
+
+// Standard lib dependencies
+#include <memory>
+
+namespace
+{
+    // The unit quad in the same order as CObjectVisualData2D::GenerateQuad
+    // 1----0
+    // |   /|
+    // |  / |
+    // | /  |
+    // 2----3
+    const float QUAD_X[4] = { 0.5f, -0.5f, -0.5f,  0.5f };
+    const float QUAD_Y[4] = { 0.5f,  0.5f, -0.5f, -0.5f };
+
+    // The verts are already in clip space so the shader gets an identity
+    const float IDENTITY_MATRIX[16] =
+        { 1.f, 0.f, 0.f, 0.f,
+          0.f, 1.f, 0.f, 0.f,
+          0.f, 0.f, 1.f, 0.f,
+          0.f, 0.f, 0.f, 1.f };
+
+    // The glyph UV is baked into the verts so the shader gets the full rect
+    const float IDENTITY_GLYPH_RECT[4] = { 0.f, 0.f, 1.f, 1.f };
+
+    // The color is baked into the verts so the shader gets white
+    const float WHITE_COLOR[4] = { 1.f, 1.f, 1.f, 1.f };
+
+    // Font quads are indexed 0,1,2 0,3,1 and the batch IBO is 0,1,2 0,2,3.
+    // Taking the font verts in this order gives the same triangles and winding.
+    const int FONT_VERT_ORDER[4] = { 1, 2, 0, 3 };
+}
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CSpriteBatchMgr::CSpriteBatchMgr() :
+    m_enabled(true),
+    m_ibo(0),
+    m_drawCount(0),
+    m_quadCount(0),
+    m_lastDrawCount(0),
+    m_lastQuadCount(0)
+{
+    m_vertVec.reserve( MAX_QUADS * 4 );
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CSpriteBatchMgr::~CSpriteBatchMgr()
+{
+    if( m_ibo > 0 )
+        glDeleteBuffers(1, &m_ibo);
+
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Create the static quad IBO
+************************************************************************/
+void CSpriteBatchMgr::CreateBuffers()
+{
+    const int indexCount( MAX_QUADS * 6 );
+
+    // Two triangles per quad to match the triangle fan of a single quad
+    std::unique_ptr<GLushort[]> upIndxBuf( new GLushort[indexCount] );
+
+    for( int i = 0; i < MAX_QUADS; ++i )
+    {
+        const int arrayIndex = i * 6;
+        const int vertIndex = i * 4;
+
+        upIndxBuf[arrayIndex]   = vertIndex;
+        upIndxBuf[arrayIndex+1] = vertIndex+1;
+        upIndxBuf[arrayIndex+2] = vertIndex+2;
+
+        upIndxBuf[arrayIndex+3] = vertIndex;
+        upIndxBuf[arrayIndex+4] = vertIndex+2;
+        upIndxBuf[arrayIndex+5] = vertIndex+3;
+    }
+
+    glGenBuffers( 1, &m_ibo );
+
+    // Bind through the manager so it's bind cache stays correct
+    CVertBufMgr::Instance().BindBuffers( 0, m_ibo );
+    glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indexCount, upIndxBuf.get(), GL_STATIC_DRAW );
+
+}   // CreateBuffers
+
+
+/************************************************************************
+*    desc:  Enable/disable batching
+************************************************************************/
+void CSpriteBatchMgr::SetEnabled( bool enabled )
+{
+    if( !enabled )
+        Flush();
+
+    m_enabled = enabled;
+
+}   // SetEnabled
+
+bool CSpriteBatchMgr::IsEnabled() const
+{
+    return m_enabled;
+
+}   // IsEnabled
+
+
+/************************************************************************
+*    desc:  Can this final matrix be baked into the vertices
+************************************************************************/
+bool CSpriteBatchMgr::IsBatchable( const float * pFinalMatrix )
+{
+    return (pFinalMatrix[3] == 0.f) && (pFinalMatrix[7] == 0.f) &&
+           (pFinalMatrix[11] == 0.f) && (pFinalMatrix[15] == 1.f);
+
+}   // IsBatchable
+
+
+/************************************************************************
+*    desc:  Add a unit quad transformed by the final matrix
+*
+*    param: const CSpriteBatchState & state - shader state of the quad
+*           const float * pFinalMatrix - scale, object and projection
+*           const CRect<float> & uv - uv of the quad's VBO
+*           const CRect<float> * pGlyphUV - sprite sheet glyph or nullptr
+************************************************************************/
+void CSpriteBatchMgr::AddQuad(
+    const CSpriteBatchState & state,
+    const float * pFinalMatrix,
+    const CRect<float> & uv,
+    const CRect<float> * pGlyphUV )
+{
+    BeginQuad( state );
+
+    const float quadU[4] = { uv.x2, uv.x1, uv.x1, uv.x2 };
+    const float quadV[4] = { uv.y1, uv.y1, uv.y2, uv.y2 };
+
+    const float * m = pFinalMatrix;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        CVertex2D vert;
+
+        // Row vector times the matrix. z is zero so the third row drops out.
+        vert.vert.x = (QUAD_X[i] * m[0]) + (QUAD_Y[i] * m[4]) + m[12];
+        vert.vert.y = (QUAD_X[i] * m[1]) + (QUAD_Y[i] * m[5]) + m[13];
+        vert.vert.z = (QUAD_X[i] * m[2]) + (QUAD_Y[i] * m[6]) + m[14];
+
+        // The sprite sheet shader offsets the uv into the glyph rect
+        // as glyph.xy + (uv * glyph.zw) so do the same here
+        if( pGlyphUV != nullptr )
+        {
+            vert.uv.u = pGlyphUV->x1 + (quadU[i] * pGlyphUV->x2);
+            vert.uv.v = pGlyphUV->y1 + (quadV[i] * pGlyphUV->y2);
+        }
+        else
+        {
+            vert.uv.u = quadU[i];
+            vert.uv.v = quadV[i];
+        }
+
+        AddVert( vert );
+    }
+
+    ++m_quadCount;
+
+}   // AddQuad
+
+
+/************************************************************************
+*    desc:  Add the quads of a font string transformed by the final matrix
+*
+*    param: const CSpriteBatchState & state - shader state of the string
+*           const float * pFinalMatrix - object and projection
+*           const CQuad2D * pQuadArray - quads of the string layout
+*           size_t quadCount - number of quads
+************************************************************************/
+void CSpriteBatchMgr::AddQuads(
+    const CSpriteBatchState & state,
+    const float * pFinalMatrix,
+    const CQuad2D * pQuadArray,
+    size_t quadCount )
+{
+    const float * m = pFinalMatrix;
+
+    for( size_t i = 0; i < quadCount; ++i )
+    {
+        BeginQuad( state );
+
+        const CQuad2D & quad = pQuadArray[i];
+
+        for( int j = 0; j < 4; ++j )
+        {
+            const CVertex2D & src = quad.vert[FONT_VERT_ORDER[j]];
+            CVertex2D vert;
+
+            vert.vert.x = (src.vert.x * m[0]) + (src.vert.y * m[4]) + (src.vert.z * m[8]) + m[12];
+            vert.vert.y = (src.vert.x * m[1]) + (src.vert.y * m[5]) + (src.vert.z * m[9]) + m[13];
+            vert.vert.z = (src.vert.x * m[2]) + (src.vert.y * m[6]) + (src.vert.z * m[10]) + m[14];
+            vert.uv = src.uv;
+
+            AddVert( vert );
+        }
+    }
+
+    m_quadCount += quadCount;
+
+}   // AddQuads
+
+
+/************************************************************************
+*    desc:  Start a quad, flushing if it can't be added to the current batch
+************************************************************************/
+void CSpriteBatchMgr::BeginQuad( const CSpriteBatchState & state )
+{
+    const size_t vertCount = GetVertCount();
+
+    if( vertCount > 0 )
+    {
+        const size_t maxVerts = (m_state.vertColorLocation > -1) ? (MAX_COLOR_QUADS * 4) : (MAX_QUADS * 4);
+
+        // A change of state or a full buffer ends the batch
+        if( !m_state.IsBatchable( state ) || (vertCount == maxVerts) )
+        {
+            Flush();
+            m_state = state;
+        }
+        else
+        {
+            // Only the color can differ and it's baked into each vert
+            m_state.color = state.color;
+        }
+    }
+    else
+    {
+        m_state = state;
+    }
+
+}   // BeginQuad
+
+
+/************************************************************************
+*    desc:  Add a transformed vert to the current batch
+************************************************************************/
+void CSpriteBatchMgr::AddVert( const CVertex2D & vert )
+{
+    if( m_state.vertColorLocation > -1 )
+        m_colorVertVec.push_back( {vert, m_state.color} );
+    else
+        m_vertVec.push_back( vert );
+
+}   // AddVert
+
+
+/************************************************************************
+*    desc:  Number of verts in the current batch
+************************************************************************/
+size_t CSpriteBatchMgr::GetVertCount() const
+{
+    if( m_state.vertColorLocation > -1 )
+        return m_colorVertVec.size();
+
+    return m_vertVec.size();
+
+}   // GetVertCount
+
+
+/************************************************************************
+*    desc:  Render what has been collected
+************************************************************************/
+void CSpriteBatchMgr::Flush()
+{
+    const size_t vertCount = GetVertCount();
+    if( vertCount == 0 )
+        return;
+
+    const bool vertColor( m_state.vertColorLocation > -1 );
+    const int VERTEX_BUF_SIZE( vertColor ? sizeof(CColorVertex2D) : sizeof(CVertex2D) );
+
+    if( m_ibo == 0 )
+        CreateBuffers();
+
+    CShaderMgr::Instance().BindShaderProgram( m_state.programID );
+
+    // Stream the verts and point the attributes at where they landed
+    CStreamBufMgr & rStreamBufMgr( CStreamBufMgr::Instance() );
+    size_t vertOffset;
+
+    if( vertColor )
+        vertOffset = rStreamBufMgr.Stream( m_colorVertVec.data(), sizeof(CColorVertex2D) * vertCount );
+    else
+        vertOffset = rStreamBufMgr.Stream( m_vertVec.data(), sizeof(CVertex2D) * vertCount );
+
+    CVertBufMgr::Instance().BindBuffers( rStreamBufMgr.GetBufferID(), m_ibo );
+
+    if( m_state.textureID > 0 )
+    {
+        const int UV_OFFSET( sizeof(CPoint<float>) );
+
+        CTextureMgr::Instance().BindTexture2D( m_state.textureID );
+        CShaderMgr::Instance().SetUniform1i( m_state.text0Location, 0 ); // 0 = TEXTURE0
+
+        glEnableVertexAttribArray( m_state.uvLocation );
+        glVertexAttribPointer( m_state.uvLocation, 2, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)(vertOffset + UV_OFFSET) );
+    }
+
+    glEnableVertexAttribArray( m_state.vertexLocation );
+    glVertexAttribPointer( m_state.vertexLocation, 3, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)vertOffset );
+
+    if( vertColor )
+    {
+        const int COLOR_OFFSET( sizeof(CVertex2D) );
+
+        glEnableVertexAttribArray( m_state.vertColorLocation );
+        glVertexAttribPointer( m_state.vertColorLocation, 4, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)(vertOffset + COLOR_OFFSET) );
+
+        CShaderMgr::Instance().SetUniform4fv( m_state.colorLocation, WHITE_COLOR );
+    }
+    else
+    {
+        CShaderMgr::Instance().SetUniform4fv( m_state.colorLocation, (float *)&m_state.color );
+    }
+
+    CShaderMgr::Instance().SetUniformMatrix4fv( m_state.matrixLocation, IDENTITY_MATRIX );
+
+    if( m_state.glyphLocation > -1 )
+        CShaderMgr::Instance().SetUniform4fv( m_state.glyphLocation, IDENTITY_GLYPH_RECT );
+
+    glDrawElements( GL_TRIANGLES, (vertCount / 4) * 6, GL_UNSIGNED_SHORT, nullptr );
+
+    // Only the batched fonts use the color attribute
+    if( vertColor )
+        glDisableVertexAttribArray( m_state.vertColorLocation );
+
+    m_vertVec.clear();
+    m_colorVertVec.clear();
+    ++m_drawCount;
+
+}   // Flush
+
+
+/************************************************************************
+*    desc:  Flush and save the stats for this frame
+************************************************************************/
+void CSpriteBatchMgr::EndFrame()
+{
+    Flush();
+
+    m_lastDrawCount = m_drawCount;
+    m_lastQuadCount = m_quadCount;
+    m_drawCount = 0;
+    m_quadCount = 0;
+
+}   // EndFrame
+
+
+/************************************************************************
+*    desc:  Stats from the last frame
+************************************************************************/
+int CSpriteBatchMgr::GetDrawCount() const
+{
+    return m_lastDrawCount;
+
+}   // GetDrawCount
+
+int CSpriteBatchMgr::GetQuadCount() const
+{
+    return m_lastQuadCount;
+
+}   // GetQuadCount
@@ -0,0 +1,178 @@
+/************************************************************************
+*    FILE NAME:       spritebatchmanager.h
+*
+*    DESCRIPTION:     Collects quads and sprite sheet frames that share
+*                     the same shader, texture and color, transforms them
+*                     on the CPU into one streaming vertex buffer and
+*                     renders each batch with one draw call. Batches are
+*                     flushed in the order they are added so the painter's
+*                     order is kept.
+*
+*                     Font strings are batched the same way. If the font
+*                     shader has an in_color attribute the color of each
+*                     string is baked into it's verts, so strings of the
+*                     same font and shader batch regardless of color.
+************************************************************************/
+
+#ifndef __sprite_batch_manager_h__
+#define __sprite_batch_manager_h__
+
+// Game lib dependencies
+#include <common/color.h>
+#include <common/rect.h>
+#include <common/vertex2d.h>
+
+// Standard lib dependencies
+#include <vector>
+#include <cstddef>
+
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <SDL_opengl.h>
+#endif
+
+// Forward declaration(s)
+class CQuad2D;
+
+// The shader state shared by every quad in a batch
+class CSpriteBatchState
+{
+public:
+
+    GLuint programID;
+    GLuint textureID;
+    GLint vertexLocation;
+    GLint uvLocation;
+    GLint text0Location;
+    GLint colorLocation;
+    GLint matrixLocation;
+    GLint glyphLocation;
+    GLint vertColorLocation;
+    CColor color;
+
+    CSpriteBatchState() :
+        programID(0), textureID(0), vertexLocation(0), uvLocation(0),
+        text0Location(0), colorLocation(0), matrixLocation(0), glyphLocation(-1),
+        vertColorLocation(-1)
+    {
+    }
+
+    // The locations come from the program so they don't need to be compared.
+    // The color only has to match when it's not baked into the verts.
+    bool IsBatchable( const CSpriteBatchState & state ) const
+    {
+        return (programID == state.programID) &&
+               (textureID == state.textureID) &&
+               ((vertColorLocation > -1) ||
+                ((color.r == state.color.r) && (color.g == state.color.g) &&
+                 (color.b == state.color.b) && (color.a == state.color.a)));
+    }
+};
+
+// Vertex with the color baked in
+class CColorVertex2D
+{
+public:
+
+    CVertex2D vertex;
+    CColor color;
+};
+
+class CSpriteBatchMgr
+{
+public:
+
+    // Max quads per draw. Limited by the GLushort indices.
+    static const int MAX_QUADS = 16384;
+
+    // Max quads per draw with the color baked in. The verts are bigger
+    // so fewer fit in a section of the stream buffer.
+    static const int MAX_COLOR_QUADS = 8192;
+
+    // Get the instance of the singleton class
+    static CSpriteBatchMgr & Instance()
+    {
+        static CSpriteBatchMgr spriteBatchMgr;
+        return spriteBatchMgr;
+    }
+
+    // Enable/disable batching. Disabling flushes anything pending.
+    void SetEnabled( bool enabled );
+    bool IsEnabled() const;
+
+    // Can this final matrix be baked into the vertices. Only matrices
+    // that leave w at 1 can be, which covers the orthographic projection.
+    static bool IsBatchable( const float * pFinalMatrix );
+
+    // Add a unit quad transformed by the final matrix. pGlyphUV is the
+    // sprite sheet glyph rect or nullptr for a plain quad.
+    void AddQuad(
+        const CSpriteBatchState & state,
+        const float * pFinalMatrix,
+        const CRect<float> & uv,
+        const CRect<float> * pGlyphUV );
+
+    // Add the quads of a font string transformed by the final matrix
+    void AddQuads(
+        const CSpriteBatchState & state,
+        const float * pFinalMatrix,
+        const CQuad2D * pQuadArray,
+        size_t quadCount );
+
+    // Render what has been collected. Must be called before anything
+    // is rendered outside of the batcher and before the buffer swap.
+    void Flush();
+
+    // Flush and save the stats for this frame
+    void EndFrame();
+
+    // Stats from the last frame
+    int GetDrawCount() const;
+    int GetQuadCount() const;
+
+private:
+
+    // Constructor
+    CSpriteBatchMgr();
+
+    // Destructor
+    ~CSpriteBatchMgr();
+
+    // Create the buffers the first time they are needed
+    void CreateBuffers();
+
+    // Start a quad, flushing if it can't be added to the current batch
+    void BeginQuad( const CSpriteBatchState & state );
+
+    // Add a transformed vert to the current batch
+    void AddVert( const CVertex2D & vert );
+
+    // Number of verts in the current batch
+    size_t GetVertCount() const;
+
+private:
+
+    // Is batching enabled
+    bool m_enabled;
+
+    // The state of the batch being collected
+    CSpriteBatchState m_state;
+
+    // Transformed verts of the batch being collected
+    std::vector<CVertex2D> m_vertVec;
+
+    // Transformed verts with the color baked in of the batch being collected
+    std::vector<CColorVertex2D> m_colorVertVec;
+
+    // Static quad IBO. The verts are streamed.
+    GLuint m_ibo;
+
+    // Stats of the current and last frame
+    int m_drawCount;
+    int m_quadCount;
+    int m_lastDrawCount;
+    int m_lastQuadCount;
+};
+
+#endif  // __sprite_batch_manager_h__
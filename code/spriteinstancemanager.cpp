@@ -0,0 +1,273 @@
+/************************************************************************
+*    FILE NAME:       spriteinstancemanager.cpp
+*
+*    DESCRIPTION:     Instanced rendering of quads and sprite sheet frames
+*                     that share the same mesh.
+************************************************************************/
+
+#if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+// Glew dependencies (have to be defined first)
+#include <GL/glew.h>
+#endif
+
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
+// Physical component dependency
+#include <managers/spriteinstancemanager.h>
+
+// Game lib dependencies
+#include <common/vertex2d.h>
+#include <managers/shadermanager.h>
+#include <managers/texturemanager.h>
+#include <managers/vertexbuffermanager.h>
+#include <managers/streambuffermanager.h>
+
+// Standard lib dependencies
+#include <cstring>
+#include <cstddef>
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CSpriteInstanceMgr::CSpriteInstanceMgr() :
+    m_checked(false),
+    m_available(false),
+    m_enabled(true),
+    m_drawCount(0),
+    m_instanceCount(0),
+    m_lastDrawCount(0),
+    m_lastInstanceCount(0)
+{
+    m_instanceVec.reserve( MAX_INSTANCES );
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CSpriteInstanceMgr::~CSpriteInstanceMgr()
+{
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Does the driver support instanced arrays
+************************************************************************/
+bool CSpriteInstanceMgr::IsAvailable()
+{
+    if( !m_checked )
+    {
+        m_checked = true;
+
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        m_available = GLEW_VERSION_3_3 || (GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced);
+        #endif
+    }
+
+    return m_available;
+
+}   // IsAvailable
+
+
+/************************************************************************
+*    desc:  Enable/disable instancing
+************************************************************************/
+void CSpriteInstanceMgr::SetEnabled( bool enabled )
+{
+    if( !enabled )
+        Flush();
+
+    m_enabled = enabled;
+
+}   // SetEnabled
+
+bool CSpriteInstanceMgr::IsEnabled() const
+{
+    return m_enabled;
+
+}   // IsEnabled
+
+
+/************************************************************************
+*    desc:  Add an instance of the mesh
+*
+*    param: const CSpriteInstanceState & state - mesh and shader state
+*           const float * pFinalMatrix - scale, object and projection
+*           const CColor & color - color of this instance
+*           const CRect<float> * pGlyphUV - sprite sheet glyph or nullptr
+************************************************************************/
+void CSpriteInstanceMgr::AddInstance(
+    const CSpriteInstanceState & state,
+    const float * pFinalMatrix,
+    const CColor & color,
+    const CRect<float> * pGlyphUV )
+{
+    // A change of mesh or state or a full buffer ends the draw
+    if( !m_instanceVec.empty() &&
+        (!m_state.IsInstanceable( state ) || ((int)m_instanceVec.size() == MAX_INSTANCES)) )
+        Flush();
+
+    if( m_instanceVec.empty() )
+        m_state = state;
+
+    m_instanceVec.emplace_back();
+    CInstance & rInstance = m_instanceVec.back();
+
+    std::memcpy( rInstance.matrix, pFinalMatrix, sizeof(rInstance.matrix) );
+    rInstance.color = color;
+
+    if( pGlyphUV != nullptr )
+        rInstance.glyph = *pGlyphUV;
+
+    ++m_instanceCount;
+
+}   // AddInstance
+
+
+/************************************************************************
+*    desc:  Enable or disable the instance attributes. The divisors are
+*           put back to zero after the draw because other shaders are
+*           free to use the same locations for per vertex data.
+*
+*    param: bool enable - enable or disable
+*           size_t offset - byte offset of the instance data in the
+*                           bound VBO
+************************************************************************/
+void CSpriteInstanceMgr::SetInstanceAttributes( bool enable, size_t offset )
+{
+    // GLES2 doesn't have attribute divisors. The manager isn't available there.
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    const GLuint divisor = enable ? 1 : 0;
+    const int INSTANCE_SIZE( sizeof(CInstance) );
+
+    for( int i = 0; i < 4; ++i )
+    {
+        const GLuint location = m_state.instMatrixLocation + i;
+
+        if( enable )
+        {
+            glEnableVertexAttribArray( location );
+            glVertexAttribPointer( location, 4, GL_FLOAT, GL_FALSE, INSTANCE_SIZE, (void*)(offset + offsetof(CInstance, matrix) + (i * 4 * sizeof(float))) );
+        }
+        else
+            glDisableVertexAttribArray( location );
+
+        glVertexAttribDivisor( location, divisor );
+    }
+
+    if( m_state.instColorLocation > -1 )
+    {
+        if( enable )
+        {
+            glEnableVertexAttribArray( m_state.instColorLocation );
+            glVertexAttribPointer( m_state.instColorLocation, 4, GL_FLOAT, GL_FALSE, INSTANCE_SIZE, (void*)(offset + offsetof(CInstance, color)) );
+        }
+        else
+            glDisableVertexAttribArray( m_state.instColorLocation );
+
+        glVertexAttribDivisor( m_state.instColorLocation, divisor );
+    }
+
+    if( m_state.instGlyphLocation > -1 )
+    {
+        if( enable )
+        {
+            glEnableVertexAttribArray( m_state.instGlyphLocation );
+            glVertexAttribPointer( m_state.instGlyphLocation, 4, GL_FLOAT, GL_FALSE, INSTANCE_SIZE, (void*)(offset + offsetof(CInstance, glyph)) );
+        }
+        else
+            glDisableVertexAttribArray( m_state.instGlyphLocation );
+
+        glVertexAttribDivisor( m_state.instGlyphLocation, divisor );
+    }
+    #endif
+
+}   // SetInstanceAttributes
+
+
+/************************************************************************
+*    desc:  Render what has been collected
+************************************************************************/
+void CSpriteInstanceMgr::Flush()
+{
+    if( m_instanceVec.empty() )
+        return;
+
+    // GLES2 doesn't have instancing. Nothing is added there because
+    // the manager isn't available.
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    const int VERTEX_BUF_SIZE( sizeof(CVertex2D) );
+
+    CShaderMgr::Instance().BindShaderProgram( m_state.programID );
+
+    // Stream the instance data and point the instance attributes at it.
+    // Bind through the manager so it's bind cache stays correct.
+    CStreamBufMgr & rStreamBufMgr( CStreamBufMgr::Instance() );
+    const size_t instOffset = rStreamBufMgr.Stream( m_instanceVec.data(), sizeof(CInstance) * m_instanceVec.size() );
+
+    CVertBufMgr::Instance().BindBuffers( rStreamBufMgr.GetBufferID(), m_state.ibo );
+
+    SetInstanceAttributes( true, instOffset );
+
+    // Point the per vertex attributes at the mesh
+    CVertBufMgr::Instance().BindBuffers( m_state.vbo, m_state.ibo );
+
+    if( m_state.textureID > 0 )
+    {
+        const int UV_OFFSET( sizeof(CPoint<float>) );
+
+        CTextureMgr::Instance().BindTexture2D( m_state.textureID );
+        CShaderMgr::Instance().SetUniform1i( m_state.text0Location, 0 ); // 0 = TEXTURE0
+
+        glEnableVertexAttribArray( m_state.uvLocation );
+        glVertexAttribPointer( m_state.uvLocation, 2, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)UV_OFFSET );
+    }
+
+    glEnableVertexAttribArray( m_state.vertexLocation );
+    glVertexAttribPointer( m_state.vertexLocation, 3, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, nullptr );
+
+    CVertBufMgr::Instance().DrawElementsInstanced(
+        m_state.drawMode, m_state.iboCount, m_state.indiceType, m_state.iboOffset, m_state.baseVertex, m_instanceVec.size() );
+
+    SetInstanceAttributes( false );
+    #endif
+
+    m_instanceVec.clear();
+    ++m_drawCount;
+
+}   // Flush
+
+
+/************************************************************************
+*    desc:  Flush and save the stats for this frame
+************************************************************************/
+void CSpriteInstanceMgr::EndFrame()
+{
+    Flush();
+
+    m_lastDrawCount = m_drawCount;
+    m_lastInstanceCount = m_instanceCount;
+    m_drawCount = 0;
+    m_instanceCount = 0;
+
+}   // EndFrame
+
+
+/************************************************************************
+*    desc:  Stats from the last frame
+************************************************************************/
+int CSpriteInstanceMgr::GetDrawCount() const
+{
+    return m_lastDrawCount;
+
+}   // GetDrawCount
+
+int CSpriteInstanceMgr::GetInstanceCount() const
+{
+    return m_lastInstanceCount;
+
+}   // GetInstanceCount
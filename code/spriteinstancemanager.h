@@ -0,0 +1,156 @@
+/************************************************************************
+*    FILE NAME:       spriteinstancemanager.h
+*
+*    DESCRIPTION:     Instanced rendering of quads and sprite sheet frames
+*                     that share the same mesh. The matrix, color and
+*                     glyph rect of each sprite go into an instance buffer
+*                     and the whole run is one glDrawElementsInstanced.
+*
+*                     The shader has to declare these vertex attributes
+*                     with a location in the shader XML:
+*                       in_instanceMatrix - mat4, uses 4 locations
+*                       in_instanceColor - vec4
+*                       in_instanceGlyph - vec4, sprite sheets only
+************************************************************************/
+
+#ifndef __sprite_instance_manager_h__
+#define __sprite_instance_manager_h__
+
+// Game lib dependencies
+#include <common/color.h>
+#include <common/rect.h>
+
+// Standard lib dependencies
+#include <vector>
+#include <cstddef>
+
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <SDL_opengl.h>
+#endif
+
+// The mesh and shader state shared by every instance in a draw
+class CSpriteInstanceState
+{
+public:
+
+    GLuint programID;
+    GLuint textureID;
+    GLuint vbo;
+    GLuint ibo;
+    GLint baseVertex;
+    GLint iboOffset;
+    GLsizei iboCount;
+    GLenum drawMode;
+    GLenum indiceType;
+    GLint vertexLocation;
+    GLint uvLocation;
+    GLint text0Location;
+    GLint instMatrixLocation;
+    GLint instColorLocation;
+    GLint instGlyphLocation;
+
+    CSpriteInstanceState() :
+        programID(0), textureID(0), vbo(0), ibo(0), baseVertex(0), iboOffset(0), iboCount(0),
+        drawMode(0), indiceType(0), vertexLocation(0), uvLocation(0),
+        text0Location(0), instMatrixLocation(-1), instColorLocation(-1),
+        instGlyphLocation(-1)
+    {
+    }
+
+    // The rest of the state comes from the program and the mesh
+    bool IsInstanceable( const CSpriteInstanceState & state ) const
+    {
+        return (programID == state.programID) &&
+               (textureID == state.textureID) &&
+               (vbo == state.vbo) &&
+               (ibo == state.ibo) &&
+               (baseVertex == state.baseVertex) &&
+               (iboOffset == state.iboOffset);
+    }
+};
+
+class CSpriteInstanceMgr
+{
+public:
+
+    // Max instances per draw
+    static const int MAX_INSTANCES = 4096;
+
+    // Get the instance of the singleton class
+    static CSpriteInstanceMgr & Instance()
+    {
+        static CSpriteInstanceMgr spriteInstanceMgr;
+        return spriteInstanceMgr;
+    }
+
+    // Does the driver support instanced arrays. Needs a GL context.
+    bool IsAvailable();
+
+    // Enable/disable instancing. Disabling flushes anything pending.
+    void SetEnabled( bool enabled );
+    bool IsEnabled() const;
+
+    // Add an instance of the mesh. pGlyphUV is the sprite sheet
+    // glyph rect or nullptr for a plain quad.
+    void AddInstance(
+        const CSpriteInstanceState & state,
+        const float * pFinalMatrix,
+        const CColor & color,
+        const CRect<float> * pGlyphUV );
+
+    // Render what has been collected. Must be called before anything
+    // is rendered outside of the instancer and before the buffer swap.
+    void Flush();
+
+    // Flush and save the stats for this frame
+    void EndFrame();
+
+    // Stats from the last frame
+    int GetDrawCount() const;
+    int GetInstanceCount() const;
+
+private:
+
+    // Constructor
+    CSpriteInstanceMgr();
+
+    // Destructor
+    ~CSpriteInstanceMgr();
+
+    // Enable or disable the instance attributes
+    void SetInstanceAttributes( bool enable, size_t offset = 0 );
+
+private:
+
+    // Per instance data in the layout of the instance attributes
+    class CInstance
+    {
+    public:
+        float matrix[16];
+        CColor color;
+        CRect<float> glyph;
+    };
+
+    // Has the driver been checked and the result
+    bool m_checked;
+    bool m_available;
+
+    // Is instancing enabled
+    bool m_enabled;
+
+    // The state of the draw being collected
+    CSpriteInstanceState m_state;
+
+    // Instances of the draw being collected
+    std::vector<CInstance> m_instanceVec;
+
+    // Stats of the current and last frame
+    int m_drawCount;
+    int m_instanceCount;
+    int m_lastDrawCount;
+    int m_lastInstanceCount;
+};
+
+#endif  // __sprite_instance_manager_h__
@@ -0,0 +1,272 @@
+/************************************************************************
+*    FILE NAME:       streambuffermanager.cpp
+*
+*    DESCRIPTION:     Ring buffer that dynamic 2D geometry is streamed
+*                     into
+************************************************************************/
+
+#if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+// Glew dependencies (have to be defined first)
+#include <GL/glew.h>
+#endif
+
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
+// Physical component dependency
+#include <managers/streambuffermanager.h>
+
+// Game lib dependencies
+#include <managers/glstatemanager.h>
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+    const size_t RING_SIZE = CStreamBufMgr::SECTION_SIZE * CStreamBufMgr::SECTION_COUNT;
+
+    // How long to wait on a fence before checking again, in nanoseconds
+    const GLuint64 FENCE_TIMEOUT = 1000000;
+}
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CStreamBufMgr::CStreamBufMgr() :
+    m_bufferID(0),
+    m_checked(false),
+    m_persistent(false),
+    m_pMapped(nullptr),
+    m_offset(0),
+    m_section(0),
+    m_streamedBytes(0),
+    m_lastStreamedBytes(0),
+    m_waitCount(0),
+    m_lastWaitCount(0)
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    for( int i = 0; i < SECTION_COUNT; ++i )
+        m_fence[i] = nullptr;
+    #endif
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CStreamBufMgr::~CStreamBufMgr()
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    for( int i = 0; i < SECTION_COUNT; ++i )
+    {
+        if( m_fence[i] != nullptr )
+            glDeleteSync( m_fence[i] );
+    }
+    #endif
+
+    if( m_bufferID > 0 )
+        glDeleteBuffers(1, &m_bufferID);
+
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Is the buffer persistently mapped. Needs a GL context.
+************************************************************************/
+bool CStreamBufMgr::IsPersistent()
+{
+    if( !m_checked )
+    {
+        m_checked = true;
+
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        m_persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+        #endif
+    }
+
+    return m_persistent;
+
+}   // IsPersistent
+
+
+/************************************************************************
+*    desc:  Create the buffer
+************************************************************************/
+void CStreamBufMgr::Create()
+{
+    glGenBuffers( 1, &m_bufferID );
+    CGLStateMgr::Instance().BindVBO( m_bufferID );
+
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    if( IsPersistent() )
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage( GL_ARRAY_BUFFER, RING_SIZE, nullptr, flags );
+        m_pMapped = (unsigned char *)glMapBufferRange( GL_ARRAY_BUFFER, 0, RING_SIZE, flags );
+
+        if( m_pMapped == nullptr )
+        {
+            throw NExcept::CCriticalException("Stream Buffer Error!",
+                boost::str( boost::format("Error mapping the stream buffer.\n\n%s\nLine: %s")
+                    % __FUNCTION__ % __LINE__ ));
+        }
+
+        return;
+    }
+    #endif
+
+    glBufferData( GL_ARRAY_BUFFER, RING_SIZE, nullptr, GL_STREAM_DRAW );
+
+}   // Create
+
+
+/************************************************************************
+*    desc:  Get the ring buffer
+************************************************************************/
+GLuint CStreamBufMgr::GetBufferID()
+{
+    if( m_bufferID == 0 )
+        Create();
+
+    return m_bufferID;
+
+}   // GetBufferID
+
+
+/************************************************************************
+*    desc:  Copy the data into the ring
+*
+*    param: const void * pData - data to copy
+*           size_t bytes - size of the data
+*
+*    ret:   size_t - byte offset of the data in the ring buffer
+************************************************************************/
+size_t CStreamBufMgr::Stream( const void * pData, size_t bytes )
+{
+    if( m_bufferID == 0 )
+        Create();
+
+    size_t offset = ((m_offset + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+    if( m_pMapped != nullptr )
+    {
+        // The mapped buffer is fenced by section so the data has to fit
+        // in one. Callers stream big data in chunks.
+        if( bytes > SECTION_SIZE )
+        {
+            throw NExcept::CCriticalException("Stream Buffer Error!",
+                boost::str( boost::format("Data is too big for the stream buffer section (%d).\n\n%s\nLine: %s")
+                    % bytes % __FUNCTION__ % __LINE__ ));
+        }
+
+        // Move to the next section when this one is full
+        if( offset + bytes > (m_section + 1) * SECTION_SIZE )
+        {
+            NextSection();
+            offset = m_offset;
+        }
+
+        std::memcpy( m_pMapped + offset, pData, bytes );
+    }
+    else
+    {
+        CGLStateMgr::Instance().BindVBO( m_bufferID );
+
+        // Orphan the buffer when the ring wraps so the driver
+        // doesn't have to wait on the GPU to finish with it. Data bigger
+        // than the ring gets a buffer of it's own size until the next wrap.
+        if( offset + bytes > RING_SIZE )
+        {
+            glBufferData( GL_ARRAY_BUFFER, std::max( RING_SIZE, bytes ), nullptr, GL_STREAM_DRAW );
+            offset = 0;
+        }
+
+        glBufferSubData( GL_ARRAY_BUFFER, offset, bytes, pData );
+    }
+
+    m_offset = offset + bytes;
+    m_streamedBytes += bytes;
+
+    return offset;
+
+}   // Stream
+
+
+/************************************************************************
+*    desc:  Fence the current section and wait for the GPU to be done
+*           with the next one
+************************************************************************/
+void CStreamBufMgr::NextSection()
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    m_fence[m_section] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+    m_section = (m_section + 1) % SECTION_COUNT;
+    m_offset = m_section * SECTION_SIZE;
+
+    GLsync & rFence = m_fence[m_section];
+
+    if( rFence != nullptr )
+    {
+        GLenum result = glClientWaitSync( rFence, 0, 0 );
+
+        if( (result == GL_TIMEOUT_EXPIRED) || (result == GL_WAIT_FAILED) )
+        {
+            ++m_waitCount;
+
+            do
+            {
+                result = glClientWaitSync( rFence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT );
+            }
+            while( result == GL_TIMEOUT_EXPIRED );
+        }
+
+        glDeleteSync( rFence );
+        rFence = nullptr;
+    }
+    #endif
+
+}   // NextSection
+
+
+/************************************************************************
+*    desc:  Fence this frame's data and start the next frame in a new
+*           section so the GPU can work on the frame while it's built
+************************************************************************/
+void CStreamBufMgr::EndFrame()
+{
+    if( (m_pMapped != nullptr) && (m_offset > m_section * SECTION_SIZE) )
+        NextSection();
+
+    m_lastStreamedBytes = m_streamedBytes;
+    m_lastWaitCount = m_waitCount;
+    m_streamedBytes = 0;
+    m_waitCount = 0;
+
+}   // EndFrame
+
+
+/************************************************************************
+*    desc:  Stats from the last frame
+************************************************************************/
+size_t CStreamBufMgr::GetStreamedBytes() const
+{
+    return m_lastStreamedBytes;
+
+}   // GetStreamedBytes
+
+int CStreamBufMgr::GetWaitCount() const
+{
+    return m_lastWaitCount;
+
+}   // GetWaitCount
@@ -0,0 +1,101 @@
+/************************************************************************
+*    FILE NAME:       streambuffermanager.h
+*
+*    DESCRIPTION:     Ring buffer that dynamic 2D geometry is streamed
+*                     into. Where GL 4.4 or ARB_buffer_storage is
+*                     available the buffer stays mapped and the ring is
+*                     split into sections that are fenced as the GPU uses
+*                     them. Otherwise the buffer is orphaned when the ring
+*                     wraps. Streamed data is good until the end of the
+*                     frame and never needs an allocation.
+************************************************************************/
+
+#ifndef __stream_buffer_manager_h__
+#define __stream_buffer_manager_h__
+
+// Standard lib dependencies
+#include <cstddef>
+
+#if defined(__IPHONEOS__) || defined(__ANDROID__)
+#include "SDL_opengles2.h"
+#else
+#include <SDL_opengl.h>
+#endif
+
+class CStreamBufMgr
+{
+public:
+
+    // Size of a fenced section and the number of sections in the ring.
+    // A section holds a full sprite batch.
+    static const size_t SECTION_SIZE = 2 * 1024 * 1024;
+    static const int SECTION_COUNT = 3;
+
+    // Alignment of the streamed data
+    static const size_t ALIGNMENT = 16;
+
+    // Get the instance of the singleton class
+    static CStreamBufMgr & Instance()
+    {
+        static CStreamBufMgr streamBufMgr;
+        return streamBufMgr;
+    }
+
+    // Copy the data into the ring. Returns it's byte offset in the buffer.
+    size_t Stream( const void * pData, size_t bytes );
+
+    // Get the ring buffer
+    GLuint GetBufferID();
+
+    // Is the buffer persistently mapped
+    bool IsPersistent();
+
+    // Fence this frame's data and start the next frame in a new section
+    void EndFrame();
+
+    // Stats from the last frame
+    size_t GetStreamedBytes() const;
+    int GetWaitCount() const;
+
+private:
+
+    // Constructor
+    CStreamBufMgr();
+
+    // Destructor
+    ~CStreamBufMgr();
+
+    // Create the buffer
+    void Create();
+
+    // Fence the current section and wait for the GPU to be done with the next
+    void NextSection();
+
+private:
+
+    GLuint m_bufferID;
+
+    // Is persistent mapping supported
+    bool m_checked;
+    bool m_persistent;
+
+    // Persistently mapped buffer
+    unsigned char * m_pMapped;
+
+    // Write position and the section it's in
+    size_t m_offset;
+    int m_section;
+
+    // Fences of the sections the GPU may still be using
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    GLsync m_fence[SECTION_COUNT];
+    #endif
+
+    // Stats of the current and last frame
+    size_t m_streamedBytes;
+    size_t m_lastStreamedBytes;
+    int m_waitCount;
+    int m_lastWaitCount;
+};
+
+#endif  // __stream_buffer_manager_h__
@@ -0,0 +1,386 @@
+/************************************************************************
+*    FILE NAME:       textlayout.cpp
+*
+*    DESCRIPTION:     Lays out a font string into lines and glyph quads
+************************************************************************/
+
+// Physical component dependency
+#include <2d/textlayout.h>
+
+// Game lib dependencies
+#include <common/font.h>
+#include <common/fontproperties.h>
+#include <common/glyphtable.h>
+#include <utilities/utf8.h>
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CTextLayout::CTextLayout() :
+    m_pFont(nullptr),
+    m_pFontProp(nullptr),
+    m_width(0.f),
+    m_lastCharDif(0.f),
+    m_firstCharOffset(0.f),
+    m_lastCharOffset(0.f),
+    m_lineCharCount(0),
+    m_wrapPending(false),
+    m_wrapSpaceInc(0.f)
+{
+}   // constructor
+
+
+/************************************************************************
+*    desc:  Lay out the string
+*
+*    param: const CFont & font - font to lay out with
+*           const std::string & str - string to lay out
+*           const CFontProperties & fontProp - kerning, wrap and alignment
+*           bool buildQuads - build the glyph quads
+************************************************************************/
+void CTextLayout::Layout(
+    const CFont & font,
+    const std::string & str,
+    const CFontProperties & fontProp,
+    bool buildQuads )
+{
+    m_pFont = &font;
+    m_pFontProp = &fontProp;
+
+    // The vectors are cleared and not freed so laying out
+    // again with the same object doesn't allocate
+    m_wordVec.clear();
+    m_glyphVec.clear();
+    m_lineOffsetVec.clear();
+
+    m_size.Reset();
+    m_width = 0.f;
+    m_lastCharDif = 0.f;
+    m_firstCharOffset = 0.f;
+    m_lastCharOffset = 0.f;
+    m_lineCharCount = 0;
+    m_wrapPending = false;
+    m_wrapSpaceInc = 0.f;
+
+    const float padding = fontProp.m_kerning + font.GetHorzPadding();
+    const CGlyphTable & glyphTable = font.GetGlyphTable();
+
+    for( size_t i = 0; i < str.size(); )
+    {
+        const uint32_t id = NUtf8::Decode( str, i );
+
+        // Line breaks are held with the word because the wrap of the
+        // space before it is decided by the length of the whole word
+        if( id == '|' )
+        {
+            m_wordVec.push_back( {nullptr, id, 0.f} );
+        }
+        else
+        {
+            const CCharData & charData = glyphTable.GetCharData( id );
+            float inc = charData.xAdvance + padding;
+
+            if( id == ' ' )
+            {
+                // Add in any additional spacing for the space character
+                inc += fontProp.m_spaceCharKerning;
+
+                // The word before this space is complete
+                AddWord();
+                AddChar( charData, id, inc );
+
+                // The line may wrap after this space depending on the next word
+                if( fontProp.m_lineWrapWidth > 0.f )
+                {
+                    m_wrapPending = true;
+                    m_wrapSpaceInc = inc;
+                }
+            }
+            else
+            {
+                m_wordVec.push_back( {&charData, id, inc} );
+            }
+        }
+    }
+
+    AddWord();
+    CloseLine( m_width );
+
+    // Subtract the extra space after the last character
+    m_size.w -= m_lastCharDif;
+    m_size.h = font.GetLineHeight();
+
+    if( buildQuads )
+        BuildQuads();
+    else
+        m_quadVec.clear();
+
+}   // Layout
+
+
+/************************************************************************
+*    desc:  Decide the wrap of the held space and add the held word
+************************************************************************/
+void CTextLayout::AddWord()
+{
+    if( m_wrapPending )
+    {
+        m_wrapPending = false;
+
+        // The line breaks at the space if the next word doesn't fit.
+        // Line breaks in the word don't count towards it's length.
+        float nextWord = 0.f;
+        for( auto & iter : m_wordVec )
+            nextWord += iter.inc;
+
+        if( m_width + nextWord >= m_pFontProp->m_lineWrapWidth )
+            CloseLine( m_width - m_wrapSpaceInc );
+    }
+
+    for( auto & iter : m_wordVec )
+    {
+        if( iter.id == '|' )
+            CloseLine( m_width );
+        else
+            AddChar( *iter.pCharData, iter.id, iter.inc );
+    }
+
+    m_wordVec.clear();
+
+}   // AddWord
+
+
+/************************************************************************
+*    desc:  Add a character to the current line
+************************************************************************/
+void CTextLayout::AddChar( const CCharData & charData, uint32_t id, float inc )
+{
+    if( m_lineCharCount == 0 )
+        m_firstCharOffset = charData.offset.w;
+
+    // Spaces only move the position
+    if( id != ' ' )
+    {
+        m_glyphVec.push_back( {&charData, m_width, (int)m_lineOffsetVec.size()} );
+        m_lastCharOffset = charData.offset.w;
+    }
+
+    m_width += inc;
+    ++m_lineCharCount;
+
+    // Get the longest width of this font string
+    if( m_size.w < m_width )
+    {
+        m_size.w = m_width;
+
+        // This is the space between this character and the next.
+        // Save this difference so that it can be subtracted at the end
+        m_lastCharDif = inc - charData.rect.x2;
+    }
+
+}   // AddChar
+
+
+/************************************************************************
+*    desc:  Close the current line and start the next
+*
+*    param: float width - width of the line for the alignment
+************************************************************************/
+void CTextLayout::CloseLine( float width )
+{
+    m_lineOffsetVec.push_back( CalcLineOffset( *m_pFont, m_pFontProp->m_hAlign, width, m_firstCharOffset, m_lastCharOffset ) );
+
+    m_width = 0.f;
+    m_lineCharCount = 0;
+
+}   // CloseLine
+
+
+/************************************************************************
+*    desc:  Build the quads once the number of lines is known
+************************************************************************/
+void CTextLayout::BuildQuads()
+{
+    const CFont & font = *m_pFont;
+    const CFontProperties & fontProp = *m_pFontProp;
+    const int lineCount = m_lineOffsetVec.size();
+
+    const float lineHeightWrap = font.GetLineHeight() + font.GetVertPadding() + fontProp.m_lineWrapHeight;
+    float lineHeightOffset = CalcLineHeightOffset( font, fontProp, lineCount );
+
+    // Get the size of the texture
+    const CSize<float> textureSize = font.GetTextureSize();
+
+    m_quadVec.resize( m_glyphVec.size() );
+
+    int line = 0;
+
+    for( size_t i = 0; i < m_glyphVec.size(); ++i )
+    {
+        const CGlyph & glyph = m_glyphVec[i];
+
+        // Move down to the glyph's line
+        for( ; line < glyph.line; ++line )
+            lineHeightOffset += -lineHeightWrap;
+
+        BuildGlyphQuad( font, *glyph.pCharData, m_lineOffsetVec[glyph.line] + glyph.x, lineHeightOffset, textureSize, m_quadVec[i] );
+    }
+
+}   // BuildQuads
+
+
+/************************************************************************
+*    desc:  Get the horizontal alignment offset of a line
+*
+*    param: const CFont & font - font of the line
+*           NDefs::EHorzAlignment hAlign - horizontal alignment
+*           float width - width of the line
+*           float firstCharOffset - offset of the first character
+*           float lastCharOffset - offset of the last non-space character
+*
+*    ret:   float - offset without a fractional component
+************************************************************************/
+float CTextLayout::CalcLineOffset(
+    const CFont & font,
+    NDefs::EHorzAlignment hAlign,
+    float width,
+    float firstCharOffset,
+    float lastCharOffset )
+{
+    float offset = 0.f;
+
+    if( hAlign == NDefs::EHA_HORZ_LEFT )
+        offset = -(firstCharOffset + font.GetHorzPadding());
+
+    else if( hAlign == NDefs::EHA_HORZ_CENTER )
+        offset = -((width + (firstCharOffset + lastCharOffset)) / 2.f);
+
+    else if( hAlign == NDefs::EHA_HORZ_RIGHT )
+        offset = -(width - lastCharOffset - font.GetHorzPadding());
+
+    // Remove any fractional component of the line offset
+    return (int)offset;
+
+}   // CalcLineOffset
+
+
+/************************************************************************
+*    desc:  Get the vertical alignment offset of the first line
+*
+*    param: const CFont & font - font of the string
+*           const CFontProperties & fontProp - alignment and wrap height
+*           int lineCount - number of lines
+*
+*    ret:   float - offset without a fractional component
+************************************************************************/
+float CTextLayout::CalcLineHeightOffset( const CFont & font, const CFontProperties & fontProp, int lineCount )
+{
+    const float lineHeightWrap = font.GetLineHeight() + font.GetVertPadding() + fontProp.m_lineWrapHeight;
+    const float initialHeightOffset = font.GetBaselineOffset() + font.GetVertPadding();
+    const float lineSpace = font.GetLineHeight() - font.GetBaselineOffset();
+    float lineHeightOffset = 0.f;
+
+    // Handle the vertical alighnmenrt
+    if( fontProp.m_vAlign == NDefs::EVA_VERT_TOP )
+        lineHeightOffset = -initialHeightOffset;
+
+    if( fontProp.m_vAlign == NDefs::EVA_VERT_CENTER )
+    {
+        lineHeightOffset = -(initialHeightOffset - ((font.GetBaselineOffset()-lineSpace) / 2.f) - font.GetVertPadding());
+
+        if( lineCount > 1 )
+            lineHeightOffset = ((lineHeightWrap * lineCount) / 2.f) - font.GetBaselineOffset();
+    }
+
+    else if( fontProp.m_vAlign == NDefs::EVA_VERT_BOTTOM )
+    {
+        lineHeightOffset = -(initialHeightOffset - font.GetBaselineOffset() - font.GetVertPadding());
+
+        if( lineCount > 1 )
+            lineHeightOffset += (lineHeightWrap * (lineCount-1));
+    }
+
+    // Remove any fractional component of the line height offset
+    return (int)lineHeightOffset;
+
+}   // CalcLineHeightOffset
+
+
+/************************************************************************
+*    desc:  Build the quad of a glyph
+*
+*    param: const CFont & font - font of the glyph
+*           const CCharData & charData - the glyph
+*           float xOffset - pen position of the glyph
+*           float lineHeightOffset - vertical offset of the glyph's line
+*           const CSize<float> & textureSize - size of the font texture
+*           CQuad2D & rQuad - quad to build
+************************************************************************/
+void CTextLayout::BuildGlyphQuad(
+    const CFont & font,
+    const CCharData & charData,
+    float xOffset,
+    float lineHeightOffset,
+    const CSize<float> & textureSize,
+    CQuad2D & rQuad )
+{
+    const CRect<float> & rect = charData.rect;
+    const float yOffset = (font.GetLineHeight() - rect.y2 - charData.offset.h) + lineHeightOffset;
+
+    // Check if the width or height is odd. If so, we offset
+    // by 0.5 for proper orthographic rendering
+    float additionalOffsetX = 0;
+    if( (int)rect.x2 % 2 != 0 )
+        additionalOffsetX = 0.5f;
+
+    float additionalOffsetY = 0;
+    if( (int)rect.y2 % 2 != 0 )
+        additionalOffsetY = 0.5f;
+
+    // Calculate the first vertex of the first face
+    rQuad.vert[0].vert.x = xOffset + charData.offset.w + additionalOffsetX;
+    rQuad.vert[0].vert.y = yOffset + additionalOffsetY;
+    rQuad.vert[0].uv.u = rect.x1 / textureSize.w;
+    rQuad.vert[0].uv.v = (rect.y1 + rect.y2) / textureSize.h;
+
+    // Calculate the second vertex of the first face
+    rQuad.vert[1].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
+    rQuad.vert[1].vert.y = yOffset + rect.y2 + additionalOffsetY;
+    rQuad.vert[1].uv.u = (rect.x1 + rect.x2) / textureSize.w;
+    rQuad.vert[1].uv.v = rect.y1 / textureSize.h;
+
+    // Calculate the third vertex of the first face
+    rQuad.vert[2].vert.x = xOffset + charData.offset.w + additionalOffsetX;
+    rQuad.vert[2].vert.y = yOffset + rect.y2 + additionalOffsetY;
+    rQuad.vert[2].uv.u = rect.x1 / textureSize.w;
+    rQuad.vert[2].uv.v = rect.y1 / textureSize.h;
+
+    // Calculate the second vertex of the second face
+    rQuad.vert[3].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
+    rQuad.vert[3].vert.y = yOffset + additionalOffsetY;
+    rQuad.vert[3].uv.u = (rect.x1 + rect.x2) / textureSize.w;
+    rQuad.vert[3].uv.v = (rect.y1 + rect.y2) / textureSize.h;
+
+}   // BuildGlyphQuad
+
+
+/************************************************************************
+*    desc:  Get the results of the last layout
+************************************************************************/
+const std::vector<CQuad2D> & CTextLayout::GetQuadVec() const
+{
+    return m_quadVec;
+
+}   // GetQuadVec
+
+const std::vector<float> & CTextLayout::GetLineOffsetVec() const
+{
+    return m_lineOffsetVec;
+
+}   // GetLineOffsetVec
+
+const CSize<float> & CTextLayout::GetSize() const
+{
+    return m_size;
+
+}   // GetSize
@@ -0,0 +1,132 @@
+/************************************************************************
+*    FILE NAME:       textlayout.h
+*
+*    DESCRIPTION:     Lays out a font string into lines and glyph quads.
+*                     The string is walked once. The word after a space
+*                     is held until the next space so the line wrap can
+*                     be decided without scanning ahead, and the line
+*                     alignment is applied when each line is closed.
+*                     Doesn't use GL so it can be run headless.
+*
+*                     The string is UTF-8 and a '|' in it forces a
+*                     line break.
+************************************************************************/
+
+#ifndef __text_layout_h__
+#define __text_layout_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <common/size.h>
+#include <common/quad2d.h>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Forward declaration(s)
+class CFont;
+class CCharData;
+class CFontProperties;
+
+class CTextLayout
+{
+public:
+
+    // Constructor
+    CTextLayout();
+
+    // Lay out the string. The quads are only built if asked for.
+    void Layout(
+        const CFont & font,
+        const std::string & str,
+        const CFontProperties & fontProp,
+        bool buildQuads = true );
+
+    // Glyph quads of the last layout, relative to the string's alignment point
+    const std::vector<CQuad2D> & GetQuadVec() const;
+
+    // Horizontal alignment offset of each line of the last layout
+    const std::vector<float> & GetLineOffsetVec() const;
+
+    // Size of the last layout
+    const CSize<float> & GetSize() const;
+
+    // Horizontal alignment offset of a line
+    static float CalcLineOffset(
+        const CFont & font,
+        NDefs::EHorzAlignment hAlign,
+        float width,
+        float firstCharOffset,
+        float lastCharOffset );
+
+    // Vertical alignment offset of the first line
+    static float CalcLineHeightOffset( const CFont & font, const CFontProperties & fontProp, int lineCount );
+
+    // Build the quad of a glyph at the pen position
+    static void BuildGlyphQuad(
+        const CFont & font,
+        const CCharData & charData,
+        float xOffset,
+        float lineHeightOffset,
+        const CSize<float> & textureSize,
+        CQuad2D & rQuad );
+
+private:
+
+    // Add a character to the current line
+    void AddChar( const CCharData & charData, uint32_t id, float inc );
+
+    // Decide the wrap of the held space and add the held word
+    void AddWord();
+
+    // Close the current line and start the next
+    void CloseLine( float width );
+
+    // Build the quads once the number of lines is known
+    void BuildQuads();
+
+private:
+
+    // A character of the held word
+    class CWordChar
+    {
+    public:
+        const CCharData * pCharData;
+        uint32_t id;
+        float inc;
+    };
+
+    // A placed glyph
+    class CGlyph
+    {
+    public:
+        const CCharData * pCharData;
+        float x;
+        int line;
+    };
+
+    const CFont * m_pFont;
+    const CFontProperties * m_pFontProp;
+
+    std::vector<CWordChar> m_wordVec;
+    std::vector<CGlyph> m_glyphVec;
+    std::vector<float> m_lineOffsetVec;
+    std::vector<CQuad2D> m_quadVec;
+
+    CSize<float> m_size;
+
+    // State of the line being laid out
+    float m_width;
+    float m_lastCharDif;
+    float m_firstCharOffset;
+    float m_lastCharOffset;
+    int m_lineCharCount;
+
+    // Is there a space the line may wrap at and it's advance
+    bool m_wrapPending;
+    float m_wrapSpaceInc;
+};
+
+#endif  // __text_layout_h__
@@ -0,0 +1,207 @@
+/************************************************************************
+*    FILE NAME:       textlayoutcache.cpp
+*
+*    DESCRIPTION:     LRU cache of laid out font strings
+************************************************************************/
+
+// Physical component dependency
+#include <managers/textlayoutcache.h>
+
+// Game lib dependencies
+#include <common/fontproperties.h>
+
+namespace
+{
+    // Add the bytes of a value to the key
+    template<typename T>
+    void AppendToKey( std::string & rKey, const T & value )
+    {
+        rKey.append( reinterpret_cast<const char *>(&value), sizeof(value) );
+    }
+}
+
+/************************************************************************
+*    desc:  Constructer
+************************************************************************/
+CTextLayoutCache::CTextLayoutCache() :
+    m_maxSize(DEFAULT_MAX_SIZE),
+    m_size(0),
+    m_hitCount(0),
+    m_missCount(0),
+    m_evictionCount(0)
+{
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructer
+************************************************************************/
+CTextLayoutCache::~CTextLayoutCache()
+{
+}   // destructer
+
+
+/************************************************************************
+*    desc:  Get the layout of the string
+*
+*    param: const CFont & font - font of the string
+*           const std::string & str - string to lay out
+*           const CFontProperties & fontProp - font name, kerning, wrap and alignment
+*
+*    ret:   std::shared_ptr<const CTextLayoutData> - the layout
+************************************************************************/
+std::shared_ptr<const CTextLayoutData> CTextLayoutCache::GetLayout(
+    const CFont & font,
+    const std::string & str,
+    const CFontProperties & fontProp )
+{
+    // The key is everything the layout depends on. The '\0' keeps
+    // the font name and string apart.
+    m_key.assign( fontProp.m_fontName );
+    m_key.push_back( '\0' );
+    m_key.append( str );
+    m_key.push_back( '\0' );
+    AppendToKey( m_key, fontProp.m_kerning );
+    AppendToKey( m_key, fontProp.m_spaceCharKerning );
+    AppendToKey( m_key, fontProp.m_lineWrapWidth );
+    AppendToKey( m_key, fontProp.m_lineWrapHeight );
+    AppendToKey( m_key, fontProp.m_hAlign );
+    AppendToKey( m_key, fontProp.m_vAlign );
+
+    auto mapIter = m_entryMap.find( m_key );
+    if( mapIter != m_entryMap.end() )
+    {
+        ++m_hitCount;
+
+        // Move it to the front of the list as the most recently used
+        m_entryList.splice( m_entryList.begin(), m_entryList, mapIter->second );
+
+        return mapIter->second->spData;
+    }
+
+    ++m_missCount;
+
+    m_textLayout.Layout( font, str, fontProp );
+
+    std::shared_ptr<CTextLayoutData> spData( new CTextLayoutData );
+    spData->quadVec = m_textLayout.GetQuadVec();
+    spData->size = m_textLayout.GetSize();
+
+    // The key is stored twice, in the list and the map
+    const size_t size = sizeof(CTextLayoutData) + (sizeof(CQuad2D) * spData->quadVec.size()) + (m_key.size() * 2);
+
+    m_entryList.push_front( {m_key, spData, size} );
+    m_entryMap.emplace( m_key, m_entryList.begin() );
+    m_size += size;
+
+    Trim();
+
+    return spData;
+
+}   // GetLayout
+
+
+/************************************************************************
+*    desc:  Drop least recently used layouts until the cache is under
+*           the cap. The newest is always kept.
+************************************************************************/
+void CTextLayoutCache::Trim()
+{
+    while( (m_size > m_maxSize) && (m_entryList.size() > 1) )
+    {
+        const CEntry & entry = m_entryList.back();
+
+        m_size -= entry.size;
+        m_entryMap.erase( entry.key );
+        m_entryList.pop_back();
+
+        ++m_evictionCount;
+    }
+
+}   // Trim
+
+
+/************************************************************************
+*    desc:  Set/Get the memory cap
+************************************************************************/
+void CTextLayoutCache::SetMaxSize( size_t maxSize )
+{
+    m_maxSize = maxSize;
+
+    Trim();
+
+}   // SetMaxSize
+
+size_t CTextLayoutCache::GetMaxSize() const
+{
+    return m_maxSize;
+
+}   // GetMaxSize
+
+
+/************************************************************************
+*    desc:  Drop all the layouts. Components keep the ones they use.
+************************************************************************/
+void CTextLayoutCache::Clear()
+{
+    m_entryMap.clear();
+    m_entryList.clear();
+    m_size = 0;
+
+}   // Clear
+
+
+/************************************************************************
+*    desc:  Memory used and number of layouts in the cache
+************************************************************************/
+size_t CTextLayoutCache::GetSize() const
+{
+    return m_size;
+
+}   // GetSize
+
+size_t CTextLayoutCache::GetCount() const
+{
+    return m_entryList.size();
+
+}   // GetCount
+
+
+/************************************************************************
+*    desc:  Stats since they were last reset
+************************************************************************/
+int CTextLayoutCache::GetHitCount() const
+{
+    return m_hitCount;
+
+}   // GetHitCount
+
+int CTextLayoutCache::GetMissCount() const
+{
+    return m_missCount;
+
+}   // GetMissCount
+
+int CTextLayoutCache::GetEvictionCount() const
+{
+    return m_evictionCount;
+
+}   // GetEvictionCount
+
+float CTextLayoutCache::GetHitRate() const
+{
+    const int total = m_hitCount + m_missCount;
+    if( total == 0 )
+        return 0.f;
+
+    return (float)m_hitCount / (float)total;
+
+}   // GetHitRate
+
+void CTextLayoutCache::ResetStats()
+{
+    m_hitCount = 0;
+    m_missCount = 0;
+    m_evictionCount = 0;
+
+}   // ResetStats
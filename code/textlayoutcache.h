@@ -0,0 +1,121 @@
+/************************************************************************
+*    FILE NAME:       textlayoutcache.h
+*
+*    DESCRIPTION:     LRU cache of laid out font strings. The layouts are
+*                     shared so components showing the same string with
+*                     the same font and properties share the quads and
+*                     only the first one lays it out. Layouts still in use
+*                     stay alive after they are dropped from the cache.
+************************************************************************/
+
+#ifndef __text_layout_cache_h__
+#define __text_layout_cache_h__
+
+// Game lib dependencies
+#include <common/size.h>
+#include <common/quad2d.h>
+#include <2d/textlayout.h>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+// Forward declaration(s)
+class CFont;
+class CFontProperties;
+
+/************************************************************************
+*    desc:  A laid out font string
+************************************************************************/
+class CTextLayoutData
+{
+public:
+
+    // Glyph quads relative to the string's alignment point
+    std::vector<CQuad2D> quadVec;
+
+    // Size of the string
+    CSize<float> size;
+};
+
+class CTextLayoutCache
+{
+public:
+
+    // Default memory cap of the cache
+    static const size_t DEFAULT_MAX_SIZE = 2 * 1024 * 1024;
+
+    // Get the instance of the singleton class
+    static CTextLayoutCache & Instance()
+    {
+        static CTextLayoutCache textLayoutCache;
+        return textLayoutCache;
+    }
+
+    // Get the layout of the string. It's laid out and cached if it's not in the cache.
+    std::shared_ptr<const CTextLayoutData> GetLayout(
+        const CFont & font,
+        const std::string & str,
+        const CFontProperties & fontProp );
+
+    // Set/Get the memory cap. Least recently used layouts are dropped to stay under it.
+    void SetMaxSize( size_t maxSize );
+    size_t GetMaxSize() const;
+
+    // Drop all the layouts, ie after the fonts are reloaded
+    void Clear();
+
+    // Memory used and number of layouts in the cache
+    size_t GetSize() const;
+    size_t GetCount() const;
+
+    // Stats since they were last reset
+    int GetHitCount() const;
+    int GetMissCount() const;
+    int GetEvictionCount() const;
+    float GetHitRate() const;
+    void ResetStats();
+
+private:
+
+    // Constructor
+    CTextLayoutCache();
+
+    // Destructor
+    ~CTextLayoutCache();
+
+    // Drop least recently used layouts until the cache is under the cap
+    void Trim();
+
+private:
+
+    class CEntry
+    {
+    public:
+        std::string key;
+        std::shared_ptr<const CTextLayoutData> spData;
+        size_t size;
+    };
+
+    // Most recently used at the front
+    std::list<CEntry> m_entryList;
+    std::unordered_map<std::string, std::list<CEntry>::iterator> m_entryMap;
+
+    // Reused for the layouts so a miss doesn't allocate the work buffers
+    CTextLayout m_textLayout;
+
+    // Reused to build the key
+    std::string m_key;
+
+    size_t m_maxSize;
+    size_t m_size;
+
+    int m_hitCount;
+    int m_missCount;
+    int m_evictionCount;
+};
+
+#endif  // __text_layout_cache_h__
@@ -12,10 +12,16 @@
 #include <SDL_opengl.h>  // SDL/OpenGL lib dependencies
 #endif
 
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
 // Physical component dependency
 #include <managers/texturemanager.h>
 
 // Game lib dependencies
+#include <managers/glstatemanager.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/settings.h>
 
@@ -33,7 +39,6 @@
 *    desc:  Constructer
 ************************************************************************/
 CTextureMgr::CTextureMgr() :
-    m_currentTextureID(0),
     m_anisotropicLevel(0)
 {
     InitAnisotropic();
@@ -88,12 +93,12 @@ const CTexture & CTextureMgr::LoadFor2D( const std::string & group, const std::s
         LoadTexture( texture, filePath, compressed );
         
         // Init with common features until I need to configure differently
-        glBindTexture(GL_TEXTURE_2D, texture.GetID());
+        CGLStateMgr::Instance().BindTexture( texture.GetID() );
         
         glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
         glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
         
-        glBindTexture(GL_TEXTURE_2D, 0);
+        CGLStateMgr::Instance().BindTexture( 0 );
 
         // Insert the new texture info
         mapIter = mapMapIter->second.emplace( filePath, texture ).first;
@@ -126,14 +131,14 @@ const CTexture & CTextureMgr::LoadFor3D( const std::string & group, const std::s
         LoadTexture( texture, filePath, compressed );
         
         // Init with common features until I need to configure differently
-        glBindTexture(GL_TEXTURE_2D, texture.GetID());
+        CGLStateMgr::Instance().BindTexture( texture.GetID() );
         
         // Set the anisotropic value
         glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, m_anisotropicLevel );
         glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
         glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
         
-        glBindTexture(GL_TEXTURE_2D, 0);
+        CGLStateMgr::Instance().BindTexture( 0 );
 
         // Insert the new texture info
         mapIter = mapMapIter->second.emplace( filePath, texture ).first;
@@ -149,6 +154,23 @@ const CTexture & CTextureMgr::LoadFor3D( const std::string & group, const std::s
 ************************************************************************/
 void CTextureMgr::LoadTexture( CTexture & texture, const std::string & filePath, bool compressed )
 {
+    #if defined(NULL_GL_BACKEND)
+    // SOIL makes it's GL calls from inside the lib so only load the image
+    // with it and upload it through the null GL backend
+    int channels(0);
+    unsigned char * pImage = SOIL_load_image( filePath.c_str(), &texture.m_size.w, &texture.m_size.h, &channels, SOIL_LOAD_AUTO );
+
+    if( pImage != nullptr )
+    {
+        const GLenum format[] = { GL_RED, GL_RED, GL_RG, GL_RGB, GL_RGBA };
+
+        glGenTextures( 1, &texture.m_id );
+        CGLStateMgr::Instance().BindTexture( texture.m_id );
+        glTexImage2D( GL_TEXTURE_2D, 0, format[channels], texture.m_size.w, texture.m_size.h, 0, format[channels], GL_UNSIGNED_BYTE, pImage );
+
+        SOIL_free_image_data( pImage );
+    }
+    #else
     texture.m_id = SOIL_load_OGL_texture(
         filePath.c_str(),
         &texture.m_size.w,
@@ -156,6 +178,7 @@ void CTextureMgr::LoadTexture( CTexture & texture, const std::string & filePath,
         SOIL_LOAD_AUTO,
         SOIL_CREATE_NEW_ID,
         (compressed == true) ? SOIL_FLAG_COMPRESS_TO_DXT : SOIL_FLAG_ORIGINAL_TEXTURE_FORMAT );
+    #endif
 
     if( texture.GetID() == 0 )
     {
@@ -178,7 +201,10 @@ void CTextureMgr::DeleteTextureGroupFor2D( const std::string & group )
     {
         // Delete all the textures in this group
         for( auto & mapIter : mapMapIter->second )
+        {
             glDeleteTextures(1, &mapIter.second.m_id);
+            CGLStateMgr::Instance().OnDeleteTexture( mapIter.second.m_id );
+        }
 
         // Erase this group
         m_textureFor2DMapMap.erase( mapMapIter );
@@ -198,7 +224,10 @@ void CTextureMgr::DeleteTextureGroupFor3D( const std::string & group )
     {
         // Delete all the textures in this group
         for( auto & mapIter : mapMapIter->second )
+        {
             glDeleteTextures(1, &mapIter.second.m_id);
+            CGLStateMgr::Instance().OnDeleteTexture( mapIter.second.m_id );
+        }
 
         // Erase this group
         m_textureFor3DMapMap.erase( mapMapIter );
@@ -209,42 +238,29 @@ void CTextureMgr::DeleteTextureGroupFor3D( const std::string & group )
 
 /************************************************************************
 *    desc:  Function call used to manage what texture is currently bound.
-*           This insures that we don't keep rebinding the same texture
+*           The GL state manager insures that we don't keep rebinding
+*           the same texture. 2D and 3D textures are both GL_TEXTURE_2D
+*           so they share the binding of the texture unit.
 ************************************************************************/
 void CTextureMgr::BindTexture2D( GLuint textureID )
 {
-    if( m_currentTextureID != textureID )
-    {
-        // save the current binding
-        m_currentTextureID = textureID;
-
-        // Have OpenGL bind this texture now
-        glBindTexture(GL_TEXTURE_2D, textureID);
-    }
+    CGLStateMgr::Instance().BindTexture( textureID );
 
 }   // BindTexture
 
 void CTextureMgr::BindTexture3D( GLuint textureID )
 {
-    if( m_currentTextureID != textureID )
-    {
-        // save the current binding
-        m_currentTextureID = textureID;
-
-        // Have OpenGL bind this texture now
-        glBindTexture(GL_TEXTURE_2D, textureID);
-    }
+    CGLStateMgr::Instance().BindTexture( textureID );
 
 }   // BindTexture
 
 
 /************************************************************************
-*    desc:  Unbind the texture and reset the flag
+*    desc:  Unbind the texture
 ************************************************************************/
 void CTextureMgr::UnbindTexture()
 {
-    m_currentTextureID = 0;
-    glBindTexture(GL_TEXTURE_2D, 0);
+    CGLStateMgr::Instance().BindTexture( 0 );
 
 }   // UnbindTexture
 
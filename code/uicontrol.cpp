@@ -22,6 +22,7 @@
 #include <system/device.h>
 #include <managers/actionmanager.h>
 #include <common/fontproperties.h>
+#include <common/affine2d.h>
 
 // Standard lib dependencies
 #include <cstring>
@@ -231,13 +232,18 @@ void CUIControl::TransformCollision()
 {
     if( WasWorldPosTranformed() && !m_size.IsEmpty() )
     {
-        CMatrix matrix, finalMatrix;
-        matrix.Scale( CSettings::Instance().GetOrthoHeightAspectRatio( NDefs::EOAR_SIZE_DIV_DEFAULT ) );
-        finalMatrix = GetMatrix() * matrix;
-        finalMatrix.InvertY();
+        // The collision is pure 2D so do the math with the 3x2 affine
+        // matrix instead of merging full 4x4 matrices
+        CMatrix matrix( GetMatrix() );
+        matrix.InvertY();
 
-        // Get half the screen size to convert to screen coordinates
+        CAffine2D finalMatrix( matrix );
+        finalMatrix.Scale( CSettings::Instance().GetOrthoHeightAspectRatio( NDefs::EOAR_SIZE_DIV_DEFAULT ) );
+
+        // Get half the screen size to convert to screen coordinates.
+        // Folding it into the translation saves adding it to each point.
         CSize<float> screenHalf = CSettings::Instance().GetSizeHalf();
+        finalMatrix.Translate( CPoint<float>( screenHalf.GetW(), screenHalf.GetH() ) );
 
         // Create the rect of the control based on half it's size
         float halfwidth = m_size.GetW() * 0.5f;
@@ -253,23 +259,10 @@ void CUIControl::TransformCollision()
         quad.point[3].x = -halfwidth + -m_sizeModifier.x1;
         quad.point[3].y = halfHeight + m_sizeModifier.y2;
 
-        finalMatrix.Transform( m_collisionQuad, quad );
-
-        // Convert the translated rect to screen coordinates
-        m_collisionQuad.point[0].x += screenHalf.GetW();
-        m_collisionQuad.point[0].y += screenHalf.GetH();
-        m_collisionQuad.point[1].x += screenHalf.GetW();
-        m_collisionQuad.point[1].y += screenHalf.GetH();
-        m_collisionQuad.point[2].x += screenHalf.GetW();
-        m_collisionQuad.point[2].y += screenHalf.GetH();
-        m_collisionQuad.point[3].x += screenHalf.GetW();
-        m_collisionQuad.point[3].y += screenHalf.GetH();
+        // Transform all four corners in one batch
+        finalMatrix.TransformBatch( m_collisionQuad.point, quad.point, 4 );
 
         finalMatrix.Transform( m_collisionCenter, CPoint<float>() );
-
-        // Convert to screen coordinates
-        m_collisionCenter.x += screenHalf.GetW();
-        m_collisionCenter.y += screenHalf.GetH();
     }
 
 }   // TransformCollision
@@ -0,0 +1,51 @@
+/************************************************************************
+*    FILE NAME:       uniformcache.cpp
+*
+*    DESCRIPTION:     Shadow copy of a shader program's uniform values so
+*                     a value that hasn't changed isn't sent to GL again
+************************************************************************/
+
+// Physical component dependency
+#include <common/uniformcache.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+/************************************************************************
+*    desc:  Is the value different from the last one set at this location
+*
+*    param: int location - uniform location
+*           const void * pValue - the value to set
+*           size_t size - size of the value in bytes
+*
+*    ret:   bool - true if the value needs to be sent to GL
+************************************************************************/
+bool CUniformCache::IsChanged( int location, const void * pValue, size_t size )
+{
+    if( (location < 0) || (size > MAX_SIZE) )
+        return true;
+
+    if( (size_t)location >= m_valueVec.size() )
+        m_valueVec.resize( location + 1 );
+
+    CValue & rValue = m_valueVec[location];
+
+    if( (rValue.size == size) && (std::memcmp( rValue.data, pValue, size ) == 0) )
+        return false;
+
+    rValue.size = size;
+    std::memcpy( rValue.data, pValue, size );
+
+    return true;
+
+}   // IsChanged
+
+
+/************************************************************************
+*    desc:  Forget all the values
+************************************************************************/
+void CUniformCache::Clear()
+{
+    m_valueVec.clear();
+
+}   // Clear
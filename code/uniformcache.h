@@ -0,0 +1,48 @@
+/************************************************************************
+*    FILE NAME:       uniformcache.h
+*
+*    DESCRIPTION:     Shadow copy of a shader program's uniform values so
+*                     a value that hasn't changed isn't sent to GL again
+************************************************************************/
+
+#ifndef __uniform_cache_h__
+#define __uniform_cache_h__
+
+// Standard lib dependencies
+#include <vector>
+#include <cstddef>
+
+class CUniformCache
+{
+public:
+
+    // Largest uniform that can be shadowed. A mat4.
+    static const size_t MAX_SIZE = sizeof(float) * 16;
+
+    // Is the value different from the last one set at this location.
+    // The new value is saved if it is. Uniforms larger than MAX_SIZE
+    // and negative locations are always reported as changed.
+    bool IsChanged( int location, const void * pValue, size_t size );
+
+    // Forget all the values, ie after the program is relinked
+    void Clear();
+
+private:
+
+    class CValue
+    {
+    public:
+
+        CValue() : size(0)
+        {}
+
+        // Size of the saved value. Zero means no value saved.
+        size_t size;
+        unsigned char data[MAX_SIZE];
+    };
+
+    // Values indexed by uniform location
+    std::vector<CValue> m_valueVec;
+};
+
+#endif  // __uniform_cache_h__
@@ -0,0 +1,94 @@
+/************************************************************************
+*    FILE NAME:       utf8.cpp
+*
+*    DESCRIPTION:     UTF-8 decoding
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/utf8.h>
+
+namespace NUtf8
+{
+    /************************************************************************
+    *    desc:  Decode the code point at the index and move the index past it
+    *
+    *    param: const std::string & str - UTF-8 string
+    *           size_t & rIndex - index of the first byte of the code point
+    *
+    *    ret:   uint32_t - code point
+    ************************************************************************/
+    uint32_t Decode( const std::string & str, size_t & rIndex )
+    {
+        const unsigned char lead = str[rIndex++];
+
+        // Plain ASCII is the common case
+        if( lead < 0x80 )
+            return lead;
+
+        int count;
+        uint32_t codePoint;
+        uint32_t minCodePoint;
+
+        if( (lead & 0xE0) == 0xC0 )
+        {
+            count = 1;
+            codePoint = lead & 0x1F;
+            minCodePoint = 0x80;
+        }
+        else if( (lead & 0xF0) == 0xE0 )
+        {
+            count = 2;
+            codePoint = lead & 0x0F;
+            minCodePoint = 0x800;
+        }
+        else if( (lead & 0xF8) == 0xF0 )
+        {
+            count = 3;
+            codePoint = lead & 0x07;
+            minCodePoint = 0x10000;
+        }
+        else
+        {
+            // A continuation byte or invalid lead byte
+            return REPLACEMENT_CHAR;
+        }
+
+        if( rIndex + count > str.size() )
+            return REPLACEMENT_CHAR;
+
+        for( int i = 0; i < count; ++i )
+        {
+            const unsigned char byte = str[rIndex + i];
+            if( (byte & 0xC0) != 0x80 )
+                return REPLACEMENT_CHAR;
+
+            codePoint = (codePoint << 6) | (byte & 0x3F);
+        }
+
+        // Overlong encodings, surrogates and code points past the
+        // end of unicode are invalid
+        if( (codePoint < minCodePoint) || (codePoint > 0x10FFFF) ||
+            ((codePoint >= 0xD800) && (codePoint <= 0xDFFF)) )
+            return REPLACEMENT_CHAR;
+
+        rIndex += count;
+
+        return codePoint;
+
+    }   // Decode
+
+
+    /************************************************************************
+    *    desc:  Number of code points in the string
+    ************************************************************************/
+    size_t Length( const std::string & str )
+    {
+        size_t length = 0;
+
+        for( size_t i = 0; i < str.size(); ++length )
+            Decode( str, i );
+
+        return length;
+
+    }   // Length
+}
@@ -0,0 +1,27 @@
+/************************************************************************
+*    FILE NAME:       utf8.h
+*
+*    DESCRIPTION:     UTF-8 decoding
+************************************************************************/
+
+#ifndef __utf8_h__
+#define __utf8_h__
+
+// Standard lib dependencies
+#include <string>
+#include <cstdint>
+
+namespace NUtf8
+{
+    // Code point an invalid sequence decodes to
+    const uint32_t REPLACEMENT_CHAR = 0xFFFD;
+
+    // Decode the code point at the index and move the index past it.
+    // Invalid sequences decode to REPLACEMENT_CHAR one byte at a time.
+    uint32_t Decode( const std::string & str, size_t & rIndex );
+
+    // Number of code points in the string
+    size_t Length( const std::string & str );
+}
+
+#endif  // __utf8_h__
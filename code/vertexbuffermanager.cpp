@@ -10,6 +10,11 @@
 #include <GL/glew.h>
 #endif
 
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
 // Physical component dependency
 #include <managers/vertexbuffermanager.h>
 
@@ -18,13 +23,30 @@
 #include <common/shaderdata.h>
 #include <common/scaledframe.h>
 #include <common/uv.h>
+#include <managers/glstatemanager.h>
+
+// Standard lib dependencies
+#include <tuple>
+#include <algorithm>
+
+namespace
+{
+    // Size of a new arena. A mesh bigger than this gets an arena of it's own.
+    const size_t VBO_ARENA_SIZE = 256 * 1024;
+    const size_t IBO_ARENA_SIZE = 16 * 1024;
+
+    // Number of character quads the font IBO starts with
+    const int MIN_FONT_QUADS = 256;
+}
 
 /************************************************************************
 *    desc:  Constructer
 ************************************************************************/
 CVertBufMgr::CVertBufMgr()
-    : m_currentVBOID(0),
-      m_currentIBOID(0),
+    : m_vaoChecked(false),
+      m_vaoAvailable(false),
+      m_baseVertexChecked(false),
+      m_baseVertexAvailable(false),
       currentMaxFontIndices(0)
 {
 }   // constructor
@@ -35,22 +57,24 @@ CVertBufMgr::CVertBufMgr()
 ************************************************************************/
 CVertBufMgr::~CVertBufMgr()
 {
-    // Free all vertex buffers in all groups
-    for( auto & mapMapIter : m_vertexBuf2DMapMap )
+    // Free all the vertex array objects. GLES2 doesn't have them.
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    for( auto & mapIter : m_vaoMap )
+        glDeleteVertexArrays(1, &mapIter.second);
+    #endif
+
+    // Free all vertex buffer arenas in all groups
+    for( auto & mapIter : m_vertexArenaMap )
     {
-        for( auto & mapIter : mapMapIter.second )
-        {
-            glDeleteBuffers(1, &mapIter.second);
-        }
+        for( auto & iter : mapIter.second )
+            glDeleteBuffers(1, &iter.id);
     }
 
-    // Free all index buffers in all groups
-    for( auto & mapMapIter : m_indexBuf2DMapMap )
+    // Free all index buffer arenas in all groups
+    for( auto & mapIter : m_indexArenaMap )
     {
-        for( auto & mapIter : mapMapIter.second )
-        {
-            glDeleteBuffers(1, &mapIter.second);
-        }
+        for( auto & iter : mapIter.second )
+            glDeleteBuffers(1, &iter.id);
     }
 
 }   // destructer
@@ -67,7 +91,7 @@ GLuint CVertBufMgr::CreateVBO(
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_vertexBuf2DMapMap.find( group );
     if( mapMapIter == m_vertexBuf2DMapMap.end() )
-        mapMapIter = m_vertexBuf2DMapMap.emplace( group, std::map<const std::string, GLuint>() ).first;
+        mapMapIter = m_vertexBuf2DMapMap.emplace( group, std::map<const std::string, CBufferRange>() ).first;
 
     // See if this vertex buffer ID has already been loaded
     auto mapIter = mapMapIter->second.find( name );
@@ -75,19 +99,14 @@ GLuint CVertBufMgr::CreateVBO(
     // If it's not found, create the vertex buffer and add it to the list
     if( mapIter == mapMapIter->second.end() )
     {
-        GLuint vboID = 0;
-        glGenBuffers( 1, &vboID );
-        glBindBuffer( GL_ARRAY_BUFFER, vboID );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CVertex2D)*vertVec.size(), vertVec.data(), GL_STATIC_DRAW );
-
-        // unbind the buffer
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        // Sub-allocate the verts from the group's arena
+        const CBufferRange range = AllocateVertices( group, vertVec );
 
         // Insert the new vertex buffer info
-        mapIter = mapMapIter->second.emplace( name, vboID ).first;
+        mapIter = mapMapIter->second.emplace( name, range ).first;
     }
 
-    return mapIter->second;
+    return mapIter->second.id;
 
 }   // CreateVBO
 
@@ -97,10 +116,13 @@ GLuint CVertBufMgr::CreateVBO(
 ************************************************************************/
 GLuint CVertBufMgr::CreateIBO( const std::string & group, const std::string & name, GLubyte indexData[], int sizeInBytes )
 {
+    // The buffer binds below would otherwise change the bound VAO
+    UnbindVertexArray();
+
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_indexBuf2DMapMap.find( group );
     if( mapMapIter == m_indexBuf2DMapMap.end() )
-            mapMapIter = m_indexBuf2DMapMap.emplace( group, std::map<const std::string, GLuint>() ).first;
+            mapMapIter = m_indexBuf2DMapMap.emplace( group, std::map<const std::string, CBufferRange>() ).first;
 
     // See if this intex buffer ID has already been loaded
     auto mapIter = mapMapIter->second.find( name );
@@ -108,66 +130,100 @@ GLuint CVertBufMgr::CreateIBO( const std::string & group, const std::string & na
     // If it's not found, create the intex buffer and add it to the list
     if( mapIter == mapMapIter->second.end() )
     {
-        GLuint iboID = 0;
-        glGenBuffers( 1, &iboID );
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
-        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeInBytes, indexData, GL_STATIC_DRAW );
-
-        // unbind the buffer
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        // Sub-allocate the indices from the group's arena
+        const CBufferRange range = AllocateRange(
+            m_indexArenaMap[group], GL_ELEMENT_ARRAY_BUFFER, IBO_ARENA_SIZE, sizeof(GLubyte), indexData, sizeInBytes );
 
         // Insert the new intex buffer info
-        mapIter = mapMapIter->second.emplace( name, iboID ).first;
+        mapIter = mapMapIter->second.emplace( name, range ).first;
     }
 
-    return mapIter->second;
+    return mapIter->second.id;
 
 }   // CreateIBO
 
 
 /************************************************************************
-*    desc:  Create a dynamic font IBO buffer
+*    desc:  Create a dynamic font IBO buffer. The IBO holds the indices
+*           of as many character quads as have been asked for so far and
+*           doubles in size when a longer string comes along. It never
+*           holds more than MAX_FONT_QUADS.
 ************************************************************************/
-GLuint CVertBufMgr::CreateDynamicFontIBO( const std::string & group, const std::string & name, GLushort * pIndexData, int maxIndicies )
+GLuint CVertBufMgr::CreateDynamicFontIBO( const std::string & group, const std::string & name, int maxIndicies )
 {
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_indexBuf2DMapMap.find( group );
     if( mapMapIter == m_indexBuf2DMapMap.end() )
-        mapMapIter = m_indexBuf2DMapMap.emplace( group, std::map<const std::string, GLuint>() ).first;
+        mapMapIter = m_indexBuf2DMapMap.emplace( group, std::map<const std::string, CBufferRange>() ).first;
 
     // See if this intex buffer ID has already been loaded
     auto mapIter = mapMapIter->second.find( name );
 
+    // Indices are shorts so only so many quads can be indexed. Longer
+    // strings are drawn in chunks of MAX_FONT_QUADS.
+    maxIndicies = std::min( maxIndicies, MAX_FONT_QUADS * 6 );
+
+    // Nothing to do if the IBO is already big enough
+    if( (mapIter != mapMapIter->second.end()) && (maxIndicies <= currentMaxFontIndices) )
+        return mapIter->second.id;
+
+    // The buffer binds below would otherwise change the bound VAO
+    UnbindVertexArray();
+
+    // Double the number of quads the IBO holds until the string fits
+    int quadCount = (mapIter == mapMapIter->second.end()) ? MIN_FONT_QUADS : (currentMaxFontIndices / 6);
+    while( quadCount * 6 < maxIndicies )
+        quadCount *= 2;
+
+    quadCount = std::min( quadCount, MAX_FONT_QUADS );
+    const int indiceCount = quadCount * 6;
+
+    // Every character quad is drawn with the same two triangles
+    std::vector<GLushort> indexVec( indiceCount );
+    for( int i = 0; i < quadCount; ++i )
+    {
+        const int arrayIndex = i * 6;
+        const GLushort vertIndex = i * 4;
+
+        indexVec[arrayIndex] = vertIndex;
+        indexVec[arrayIndex+1] = vertIndex+1;
+        indexVec[arrayIndex+2] = vertIndex+2;
+
+        indexVec[arrayIndex+3] = vertIndex;
+        indexVec[arrayIndex+4] = vertIndex+3;
+        indexVec[arrayIndex+5] = vertIndex+1;
+    }
+
+    const size_t size = sizeof(GLushort) * indiceCount;
+
     // If it's not found, create the intex buffer and add it to the list
     if( mapIter == mapMapIter->second.end() )
     {
         GLuint iboID = 0;
         glGenBuffers( 1, &iboID );
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
-        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * maxIndicies, pIndexData, GL_DYNAMIC_DRAW );
-
-        // unbind the buffer
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        CGLStateMgr::Instance().BindIBO( iboID );
+        glBufferData( GL_ELEMENT_ARRAY_BUFFER, size, indexVec.data(), GL_STATIC_DRAW );
 
         // Insert the new intex buffer info
-        mapIter = mapMapIter->second.emplace( name, iboID ).first;
+        mapIter = mapMapIter->second.emplace( name, CBufferRange(iboID, 0) ).first;
 
-        // Save the number of indices for later to compair and expand this size of this IBO
-        currentMaxFontIndices = maxIndicies;
+        // The font IBO grows so it's not sub-allocated. Add it to the group's
+        // arenas as a full arena so it's freed with the group.
+        m_indexArenaMap[group].emplace_back( iboID, size, size );
     }
     else
     {
-        // If the new indices are greater then the current, init the IBO with the newest
-        if( maxIndicies > currentMaxFontIndices )
-        {
-            glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, mapIter->second );
-            glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * maxIndicies, pIndexData, GL_DYNAMIC_DRAW );
-
-            currentMaxFontIndices = maxIndicies;
-        }
+        CGLStateMgr::Instance().BindIBO( mapIter->second.id );
+        glBufferData( GL_ELEMENT_ARRAY_BUFFER, size, indexVec.data(), GL_STATIC_DRAW );
     }
 
-    return mapIter->second;
+    // unbind the buffer
+    CGLStateMgr::Instance().BindIBO( 0 );
+
+    // Save the number of indices for later to compair and expand this size of this IBO
+    currentMaxFontIndices = indiceCount;
+
+    return mapIter->second.id;
 
 }   // CreateDynamicFontIBO
 
@@ -188,7 +244,7 @@ GLuint CVertBufMgr::CreateScaledFrame(
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_vertexBuf2DMapMap.find( group );
     if( mapMapIter == m_vertexBuf2DMapMap.end() )
-        mapMapIter = m_vertexBuf2DMapMap.emplace( group, std::map<const std::string, GLuint>() ).first;
+        mapMapIter = m_vertexBuf2DMapMap.emplace( group, std::map<const std::string, CBufferRange>() ).first;
 
     // See if this vertex buffer ID has already been loaded
     auto mapIter = mapMapIter->second.find( name );
@@ -206,19 +262,14 @@ GLuint CVertBufMgr::CreateScaledFrame(
         if( !vertVecTmp.empty() )
             vertVecTmp.insert( vertVecTmp.end(), vertVec.begin(), vertVec.end() );
 
-        GLuint vboID = 0;
-        glGenBuffers( 1, &vboID );
-        glBindBuffer( GL_ARRAY_BUFFER, vboID );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CVertex2D)*vertVecTmp.size(), vertVecTmp.data(), GL_STATIC_DRAW );
-
-        // unbind the buffer
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        // Sub-allocate the verts from the group's arena
+        const CBufferRange range = AllocateVertices( group, vertVecTmp );
 
         // Insert the new vertex buffer info
-        mapIter = mapMapIter->second.emplace( name, vboID ).first;
+        mapIter = mapMapIter->second.emplace( name, range ).first;
     }
 
-    return mapIter->second;
+    return mapIter->second.id;
 
 }   // CreateScaledFrame
 
@@ -400,84 +451,355 @@ GLuint CVertBufMgr::IsVBO( const std::string & group, const std::string & name )
     if( mapIter == mapMapIter->second.end() )
         return 0;
 
-    return mapIter->second;
+    return mapIter->second.id;
 }
 
 
+/************************************************************************
+*    desc:  Get the first vertex of a VBO in it's arena. Draw with it as
+*           the base vertex.
+************************************************************************/
+int CVertBufMgr::GetBaseVertex( const std::string & group, const std::string & name ) const
+{
+    auto mapMapIter = m_vertexBuf2DMapMap.find( group );
+    if( mapMapIter == m_vertexBuf2DMapMap.end() )
+        return 0;
+
+    auto mapIter = mapMapIter->second.find( name );
+    if( mapIter == mapMapIter->second.end() )
+        return 0;
+
+    return mapIter->second.offset / sizeof(CVertex2D);
+
+}   // GetBaseVertex
+
+
+/************************************************************************
+*    desc:  Get the byte offset of an IBO in it's arena. Draw with it as
+*           the offset of the indices.
+************************************************************************/
+int CVertBufMgr::GetIBOOffset( const std::string & group, const std::string & name ) const
+{
+    auto mapMapIter = m_indexBuf2DMapMap.find( group );
+    if( mapMapIter == m_indexBuf2DMapMap.end() )
+        return 0;
+
+    auto mapIter = mapMapIter->second.find( name );
+    if( mapIter == mapMapIter->second.end() )
+        return 0;
+
+    return mapIter->second.offset;
+
+}   // GetIBOOffset
+
+
+/************************************************************************
+*    desc:  Sub-allocate verts from the group's arena. Without base vertex
+*           draws the verts have to start at the front of the buffer so
+*           each mesh gets a buffer of it's own.
+************************************************************************/
+CBufferRange CVertBufMgr::AllocateVertices( const std::string & group, const std::vector<CVertex2D> & vertVec )
+{
+    const size_t arenaSize = IsBaseVertexAvailable() ? VBO_ARENA_SIZE : 0;
+
+    return AllocateRange(
+        m_vertexArenaMap[group], GL_ARRAY_BUFFER, arenaSize, sizeof(CVertex2D), vertVec.data(), sizeof(CVertex2D) * vertVec.size() );
+
+}   // AllocateVertices
+
+
+/************************************************************************
+*    desc:  Sub-allocate a range from the newest arena and upload the
+*           data to it. A new arena is created when it doesn't fit.
+*
+*    param: std::vector<CBufferArena> & rArenaVec - arenas of the group
+*           GLenum target - GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+*           size_t arenaSize - size of a new arena
+*           size_t align - alignment of the range
+*           const void * pData, size_t bytes - data to upload
+*
+*    ret:   CBufferRange - buffer and offset of the data
+************************************************************************/
+CBufferRange CVertBufMgr::AllocateRange(
+    std::vector<CBufferArena> & rArenaVec,
+    GLenum target,
+    size_t arenaSize,
+    size_t align,
+    const void * pData,
+    size_t bytes )
+{
+    CBufferRange range;
+
+    const bool newArena = rArenaVec.empty() || !rArenaVec.back().Allocate( bytes, align, range.offset );
+
+    if( newArena )
+    {
+        GLuint bufferID = 0;
+        glGenBuffers( 1, &bufferID );
+
+        rArenaVec.emplace_back( bufferID, std::max( arenaSize, bytes ), 0 );
+        rArenaVec.back().Allocate( bytes, align, range.offset );
+    }
+
+    range.id = rArenaVec.back().id;
+
+    if( target == GL_ARRAY_BUFFER )
+        CGLStateMgr::Instance().BindVBO( range.id );
+    else
+        CGLStateMgr::Instance().BindIBO( range.id );
+
+    if( newArena )
+        glBufferData( target, rArenaVec.back().size, nullptr, GL_STATIC_DRAW );
+
+    glBufferSubData( target, range.offset, bytes, pData );
+
+    // unbind the buffer
+    if( target == GL_ARRAY_BUFFER )
+        CGLStateMgr::Instance().BindVBO( 0 );
+    else
+        CGLStateMgr::Instance().BindIBO( 0 );
+
+    return range;
+
+}   // AllocateRange
+
+
 /************************************************************************
 *    desc:  Function call used to manage what buffer is currently bound.
-*           This insures that we don't keep rebinding the same buffer
+*           The GL state manager insures that we don't keep rebinding
+*           the same buffer
 ************************************************************************/
 void CVertBufMgr::BindBuffers( GLuint vboID, GLuint iboID )
 {
-    if( m_currentVBOID != vboID )
+    CGLStateMgr & rState( CGLStateMgr::Instance() );
+
+    // The IBO binding is part of the VAO so go back to the default
+    rState.BindVAO( 0, 0 );
+    rState.BindVBO( vboID );
+    rState.BindIBO( iboID );
+
+}   // BindBuffers
+
+
+/************************************************************************
+*    desc:  Unbind the buffers
+************************************************************************/
+void CVertBufMgr::UnbindBuffers()
+{
+    BindBuffers( 0, 0 );
+
+}   // UnbindTexture
+
+
+/************************************************************************
+*    desc:  Draw a mesh that was sub-allocated from an arena
+*
+*    param: GLenum mode, GLsizei count, GLenum type - as glDrawElements
+*           int iboOffset - byte offset of the indices in the IBO
+*           int baseVertex - first vertex of the mesh in the VBO
+************************************************************************/
+void CVertBufMgr::DrawElements( GLenum mode, GLsizei count, GLenum type, int iboOffset, int baseVertex )
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    if( baseVertex > 0 )
     {
-        // save the current binding
-        m_currentVBOID = vboID;
+        glDrawElementsBaseVertex( mode, count, type, (void*)(size_t)iboOffset, baseVertex );
+        return;
+    }
+    #endif
 
-        // Have OpenGL bind this buffer now
-        glBindBuffer( GL_ARRAY_BUFFER, vboID );
+    glDrawElements( mode, count, type, (void*)(size_t)iboOffset );
+
+}   // DrawElements
+
+void CVertBufMgr::DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, int iboOffset, int baseVertex, GLsizei instanceCount )
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    if( baseVertex > 0 )
+    {
+        glDrawElementsInstancedBaseVertex( mode, count, type, (void*)(size_t)iboOffset, instanceCount, baseVertex );
+        return;
     }
 
-    if( m_currentIBOID != iboID )
+    // GLES2 doesn't have instancing. The instance manager isn't available there.
+    glDrawElementsInstanced( mode, count, type, (void*)(size_t)iboOffset, instanceCount );
+    #endif
+
+}   // DrawElementsInstanced
+
+
+/************************************************************************
+*    desc:  Are vertex array objects supported. Needs a GL context.
+************************************************************************/
+bool CVertBufMgr::IsVAOAvailable()
+{
+    if( !m_vaoChecked )
     {
-        // save the current binding
-        m_currentIBOID = iboID;
+        m_vaoChecked = true;
 
-        // Have OpenGL bind this buffer now
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        m_vaoAvailable = GLEW_VERSION_3_0 || GLEW_ARB_vertex_array_object;
+        #endif
     }
 
-}   // BindBuffers
+    return m_vaoAvailable;
+
+}   // IsVAOAvailable
 
 
 /************************************************************************
-*    desc:  Unbind the buffers and reset the flag
+*    desc:  Are base vertex draws supported. Needs a GL context.
 ************************************************************************/
-void CVertBufMgr::UnbindBuffers()
+bool CVertBufMgr::IsBaseVertexAvailable()
 {
-    m_currentVBOID = 0;
-    m_currentIBOID = 0;
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+    if( !m_baseVertexChecked )
+    {
+        m_baseVertexChecked = true;
 
-}   // UnbindTexture
+        #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+        m_baseVertexAvailable = GLEW_VERSION_3_2 || GLEW_ARB_draw_elements_base_vertex;
+        #endif
+    }
+
+    return m_baseVertexAvailable;
+
+}   // IsBaseVertexAvailable
 
 
 /************************************************************************
-*    desc:  Delete buffer group
+*    desc:  Get the VAO for this VBO, IBO and program. The VAO is created
+*           with the position and uv attributes the first time.
+*
+*    param: GLuint vboID, iboID, programID - what the VAO is for
+*           GLint vertexLocation - location of the position attribute
+*           GLint uvLocation - location of the uv attribute, -1 for none
+*
+*    ret:   GLuint - VAO ID or 0 if VAOs are not supported
 ************************************************************************/
-void CVertBufMgr::DeleteBufferGroupFor2D( const std::string & group )
+GLuint CVertBufMgr::GetVAO( GLuint vboID, GLuint iboID, GLuint programID, GLint vertexLocation, GLint uvLocation )
 {
+    if( !IsVAOAvailable() )
+        return 0;
+
+    const auto key = std::make_tuple( vboID, iboID, programID );
+
+    auto mapIter = m_vaoMap.find( key );
+    if( mapIter != m_vaoMap.end() )
+        return mapIter->second;
+
+    const int VERTEX_BUF_SIZE( sizeof(CVertex2D) );
+
+    GLuint vaoID = 0;
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    glGenVertexArrays( 1, &vaoID );
+    #endif
+    BindVAO( vaoID, iboID );
+
+    // The IBO binding is saved in the VAO, the VBO binding is not. The state
+    // manager already takes iboID as bound so it's bound directly here.
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
+    CGLStateMgr::Instance().BindVBO( vboID );
+
+    glEnableVertexAttribArray( vertexLocation );
+    glVertexAttribPointer( vertexLocation, 3, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, nullptr );
+
+    if( uvLocation > -1 )
     {
-        auto mapMapIter = m_vertexBuf2DMapMap.find( group );
-        if( mapMapIter != m_vertexBuf2DMapMap.end() )
-        {
-            // Delete all the buffers in this group
-            for( auto & mapIter : mapMapIter->second )
-            {
-                glDeleteBuffers(1, &mapIter.second);
-            }
-
-            // Erase this group
-            m_vertexBuf2DMapMap.erase( mapMapIter );
-        }
+        const int UV_OFFSET( sizeof(CPoint<float>) );
+
+        glEnableVertexAttribArray( uvLocation );
+        glVertexAttribPointer( uvLocation, 2, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)UV_OFFSET );
     }
 
+    m_vaoMap.emplace( key, vaoID );
+
+    return vaoID;
+
+}   // GetVAO
+
+
+/************************************************************************
+*    desc:  Bind a VAO through the GL state manager. Binding a VAO also
+*           binds it's IBO.
+*
+*    param: GLuint vaoID - VAO to bind
+*           GLuint iboID - IBO saved in the VAO
+************************************************************************/
+void CVertBufMgr::BindVAO( GLuint vaoID, GLuint iboID )
+{
+    CGLStateMgr::Instance().BindVAO( vaoID, iboID );
+
+}   // BindVAO
+
+
+/************************************************************************
+*    desc:  Go back to the default VAO
+************************************************************************/
+void CVertBufMgr::UnbindVertexArray()
+{
+    CGLStateMgr::Instance().BindVAO( 0, 0 );
+
+}   // UnbindVertexArray
+
+
+/************************************************************************
+*    desc:  Delete the VAOs that use this buffer. Must be called when a
+*           buffer is deleted because GL can give the name to a new
+*           buffer that the VAO doesn't point to.
+************************************************************************/
+void CVertBufMgr::DeleteVAOs( GLuint bufferID )
+{
+    #if !(defined(__IPHONEOS__) || defined(__ANDROID__))
+    for( auto mapIter = m_vaoMap.begin(); mapIter != m_vaoMap.end(); )
     {
-        auto mapMapIter = m_indexBuf2DMapMap.find( group );
-        if( mapMapIter != m_indexBuf2DMapMap.end() )
+        if( (std::get<0>(mapIter->first) == bufferID) || (std::get<1>(mapIter->first) == bufferID) )
         {
-            // Delete all the buffers in this group
-            for( auto & mapIter : mapMapIter->second )
-            {
-                glDeleteBuffers(1, &mapIter.second);
-            }
-
-            // Erase this group
-            m_indexBuf2DMapMap.erase( mapMapIter );
+            if( CGLStateMgr::Instance().GetVAO() == mapIter->second )
+                UnbindVertexArray();
+
+            glDeleteVertexArrays( 1, &mapIter->second );
+            CGLStateMgr::Instance().OnDeleteVAO( mapIter->second );
+            mapIter = m_vaoMap.erase( mapIter );
         }
+        else
+            ++mapIter;
     }
+    #endif
+
+}   // DeleteVAOs
+
+
+/************************************************************************
+*    desc:  Delete buffer group. The meshes are sub-allocated from the
+*           group's arenas so only the arenas need to be deleted.
+************************************************************************/
+void CVertBufMgr::DeleteBufferGroupFor2D( const std::string & group )
+{
+    DeleteArenas( m_vertexArenaMap, group );
+    DeleteArenas( m_indexArenaMap, group );
+
+    m_vertexBuf2DMapMap.erase( group );
+    m_indexBuf2DMapMap.erase( group );
 
 }   // DeleteVertexBufGroupFor2D
 
+
+/************************************************************************
+*    desc:  Delete the arenas of a group
+************************************************************************/
+void CVertBufMgr::DeleteArenas( std::map<const std::string, std::vector<CBufferArena>> & rArenaMap, const std::string & group )
+{
+    auto mapIter = rArenaMap.find( group );
+    if( mapIter != rArenaMap.end() )
+    {
+        for( auto & iter : mapIter->second )
+        {
+            DeleteVAOs( iter.id );
+            glDeleteBuffers(1, &iter.id);
+            CGLStateMgr::Instance().OnDeleteBuffer( iter.id );
+        }
+
+        rArenaMap.erase( mapIter );
+    }
+
+}   // DeleteArenas
@@ -0,0 +1,379 @@
+/************************************************************************
+*    FILE NAME:       viewcull.cpp
+*
+*    DESCRIPTION:     View rect and frustum culling. The view values are
+*                     cached once per frame so the tests don't go back to
+*                     the settings for every object, and whole arrays of
+*                     bounding circles or spheres are culled in one pass.
+************************************************************************/
+
+// Physical component dependency
+#include <common/viewcull.h>
+
+// Game lib dependencies
+#include <common/matrixsimd.h>
+#include <common/size.h>
+#include <utilities/settings.h>
+
+// Standard lib dependencies
+#include <cmath>
+#include <cstring>
+
+#if defined(MATRIX_SIMD_X86)
+    #include <emmintrin.h>
+#endif
+
+#if defined(MATRIX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define CULL_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+    #define CULL_TARGET_SSE2
+#endif
+
+namespace
+{
+    /************************************************************************
+    *    desc:  Should the SSE2 kernels be used
+    ************************************************************************/
+    inline bool UseSSE2()
+    {
+        #if defined(MATRIX_SIMD_X86)
+        return (NMatrixSimd::GetKernel() != NMatrixSimd::EK_SCALAR);
+        #else
+        return false;
+        #endif
+
+    }   // UseSSE2
+
+    /************************************************************************
+    *    desc:  Scalar circle tests against the half extents of the view
+    ************************************************************************/
+    inline bool CircleInRect( float x, float y, float halfW, float halfH, float radius )
+    {
+        return (std::fabs(x) <= (halfW + radius)) && (std::fabs(y) <= (halfH + radius));
+
+    }   // CircleInRect
+
+    #if defined(MATRIX_SIMD_X86)
+
+    /************************************************************************
+    *    desc:  SSE2 circle culling. Does blocks of four and returns the
+    *           number done. The remainder is scalar.
+    ************************************************************************/
+    CULL_TARGET_SSE2
+    int CullCirclesSSE2(
+        uint * pVisibleMask, bool perspective,
+        float halfW, float halfH,
+        const float * pX, const float * pY, const float * pDepth,
+        const float * pRadius, int count )
+    {
+        const int blockCount = count & ~3;
+        const __m128 absMask = _mm_castsi128_ps( _mm_set1_epi32( 0x7FFFFFFF ) );
+        const __m128 halfW4 = _mm_set1_ps( halfW );
+        const __m128 halfH4 = _mm_set1_ps( halfH );
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const __m128 radius = _mm_loadu_ps( pRadius + i );
+
+            __m128 extentW = halfW4;
+            __m128 extentH = halfH4;
+
+            // The perspective view widens with the distance from the camera
+            if( perspective )
+            {
+                const __m128 depth = _mm_and_ps( _mm_loadu_ps( pDepth + i ), absMask );
+                extentW = _mm_mul_ps( depth, halfW4 );
+                extentH = _mm_mul_ps( depth, halfH4 );
+            }
+
+            const __m128 inX = _mm_cmple_ps( _mm_and_ps( _mm_loadu_ps( pX + i ), absMask ), _mm_add_ps( extentW, radius ) );
+            const __m128 inY = _mm_cmple_ps( _mm_and_ps( _mm_loadu_ps( pY + i ), absMask ), _mm_add_ps( extentH, radius ) );
+
+            pVisibleMask[i >> 5] |= uint(_mm_movemask_ps( _mm_and_ps( inX, inY ) )) << (i & 31);
+        }
+
+        return blockCount;
+
+    }   // CullCirclesSSE2
+
+    /************************************************************************
+    *    desc:  SSE2 sphere culling against the frustum planes
+    ************************************************************************/
+    CULL_TARGET_SSE2
+    int CullSpheresSSE2(
+        uint * pVisibleMask, const float plane[6][4],
+        const float * pX, const float * pY, const float * pZ,
+        const float * pRadius, int count )
+    {
+        const int blockCount = count & ~3;
+
+        for( int i = 0; i < blockCount; i += 4 )
+        {
+            const __m128 x = _mm_loadu_ps( pX + i );
+            const __m128 y = _mm_loadu_ps( pY + i );
+            const __m128 z = _mm_loadu_ps( pZ + i );
+            const __m128 negRadius = _mm_sub_ps( _mm_setzero_ps(), _mm_loadu_ps( pRadius + i ) );
+
+            __m128 inside = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+
+            for( int p = 0; p < 6; ++p )
+            {
+                const __m128 dist = _mm_add_ps(
+                    _mm_add_ps( _mm_mul_ps( x, _mm_set1_ps( plane[p][0] ) ), _mm_mul_ps( y, _mm_set1_ps( plane[p][1] ) ) ),
+                    _mm_add_ps( _mm_mul_ps( z, _mm_set1_ps( plane[p][2] ) ), _mm_set1_ps( plane[p][3] ) ) );
+
+                inside = _mm_and_ps( inside, _mm_cmpge_ps( dist, negRadius ) );
+            }
+
+            pVisibleMask[i >> 5] |= uint(_mm_movemask_ps( inside )) << (i & 31);
+        }
+
+        return blockCount;
+
+    }   // CullSpheresSSE2
+
+    #endif  // MATRIX_SIMD_X86
+
+    /************************************************************************
+    *    desc:  Count the bits set in the mask
+    ************************************************************************/
+    int CountVisible( const uint * pVisibleMask, int count )
+    {
+        int visible = 0;
+
+        for( int i = 0; i < CViewCull::GetMaskSize( count ); ++i )
+            for( uint bits = pVisibleMask[i]; bits; bits &= bits - 1 )
+                ++visible;
+
+        return visible;
+
+    }   // CountVisible
+}
+
+
+/************************************************************************
+*    desc:  Constructor
+************************************************************************/
+CViewCull::CViewCull() :
+    m_orthoHalfW(0),
+    m_orthoHalfH(0),
+    m_aspectW(0),
+    m_aspectH(0)
+{
+    // Planes that pass everything until a view projection is set
+    for( int i = 0; i < 6; ++i )
+    {
+        m_plane[i][0] = 0;
+        m_plane[i][1] = 0;
+        m_plane[i][2] = 0;
+        m_plane[i][3] = 1;
+    }
+
+    Update();
+
+}   // constructor
+
+
+/************************************************************************
+*    desc:  destructor
+************************************************************************/
+CViewCull::~CViewCull()
+{
+}   // destructor
+
+
+/************************************************************************
+*    desc:  Cache the view values from the settings. Called by the
+*           device when the projection matrixes are created, which is
+*           when the screen size changes.
+************************************************************************/
+void CViewCull::Update()
+{
+    const CSize<float> & sizeHalf = CSettings::Instance().GetDefaultSizeHalf();
+    m_orthoHalfW = sizeHalf.w;
+    m_orthoHalfH = sizeHalf.h;
+
+    const CSize<float> & aspectRatio = CSettings::Instance().GetScreenAspectRatio();
+    m_aspectW = aspectRatio.w;
+    m_aspectH = aspectRatio.h;
+
+}   // Update
+
+
+/************************************************************************
+*    desc:  Build the frustum planes from a view projection matrix. The
+*           planes are pulled from the columns of the matrix because
+*           of the row vector convention.
+************************************************************************/
+void CViewCull::SetViewProjection( const CMatrix & viewProj )
+{
+    const float * pMat = viewProj();
+
+    for( int i = 0; i < 4; ++i )
+    {
+        const float col0 = pMat[(i*4)];
+        const float col1 = pMat[(i*4)+1];
+        const float col2 = pMat[(i*4)+2];
+        const float col3 = pMat[(i*4)+3];
+
+        m_plane[0][i] = col3 + col0;  // left
+        m_plane[1][i] = col3 - col0;  // right
+        m_plane[2][i] = col3 + col1;  // bottom
+        m_plane[3][i] = col3 - col1;  // top
+        m_plane[4][i] = col3 + col2;  // near
+        m_plane[5][i] = col3 - col2;  // far
+    }
+
+    // Normalize so the distances can be compared against the radius
+    for( int i = 0; i < 6; ++i )
+    {
+        const float length = std::sqrt( (m_plane[i][0] * m_plane[i][0]) +
+                                        (m_plane[i][1] * m_plane[i][1]) +
+                                        (m_plane[i][2] * m_plane[i][2]) );
+
+        if( length > 0.0f )
+        {
+            for( int j = 0; j < 4; ++j )
+                m_plane[i][j] /= length;
+        }
+    }
+
+}   // SetViewProjection
+
+
+/************************************************************************
+*    desc:  Is the bounding circle in view
+************************************************************************/
+bool CViewCull::InView( NDefs::EProjectionType type, const CPoint<float> & pos, float depth, float radius ) const
+{
+    if( type == NDefs::EPT_ORTHOGRAPHIC )
+        return InOrthographicView( pos, radius );
+
+    else if( type == NDefs::EPT_PERSPECTIVE )
+        return InPerspectiveView( pos, depth, radius );
+
+    return true;
+
+}   // InView
+
+
+/************************************************************************
+*    desc:  Check if a circle is within the orthographic view
+************************************************************************/
+bool CViewCull::InOrthographicView( const CPoint<float> & pos, float radius ) const
+{
+    return CircleInRect( pos.x, pos.y, m_orthoHalfW, m_orthoHalfH, radius );
+
+}   // InOrthographicView
+
+
+/************************************************************************
+*    desc:  Check if a circle is within the perspective view
+************************************************************************/
+bool CViewCull::InPerspectiveView( const CPoint<float> & pos, float depth, float radius ) const
+{
+    depth = std::fabs(depth);
+
+    return CircleInRect( pos.x, pos.y, depth * m_aspectW, depth * m_aspectH, radius );
+
+}   // InPerspectiveView
+
+
+/************************************************************************
+*    desc:  Is the bounding sphere inside the frustum planes
+************************************************************************/
+bool CViewCull::InFrustum( const CPoint<float> & pos, float radius ) const
+{
+    for( int i = 0; i < 6; ++i )
+    {
+        const float dist = (pos.x * m_plane[i][0]) + (pos.y * m_plane[i][1]) + (pos.z * m_plane[i][2]) + m_plane[i][3];
+
+        if( dist < -radius )
+            return false;
+    }
+
+    return true;
+
+}   // InFrustum
+
+
+/************************************************************************
+*    desc:  Cull arrays of bounding circles
+*
+*    param: uint * pVisibleMask - one bit per circle, GetMaskSize(count)
+*           NDefs::EProjectionType type - projection the circles are in
+*           const float * pX, pY - positions relative to the camera
+*           const float * pDepth - depth for the perspective projection
+*           const float * pRadius - radius of each circle
+*           int count - number of circles
+*
+*    ret:   int - number of circles in view
+************************************************************************/
+int CViewCull::CullCircles(
+    uint * pVisibleMask, NDefs::EProjectionType type,
+    const float * pX, const float * pY, const float * pDepth,
+    const float * pRadius, int count ) const
+{
+    std::memset( pVisibleMask, 0, GetMaskSize( count ) * sizeof(uint) );
+
+    // Anything other than these two projections is never culled
+    if( (type != NDefs::EPT_ORTHOGRAPHIC) && (type != NDefs::EPT_PERSPECTIVE) )
+    {
+        for( int i = 0; i < count; ++i )
+            pVisibleMask[i >> 5] |= 1u << (i & 31);
+
+        return count;
+    }
+
+    const bool perspective = (type == NDefs::EPT_PERSPECTIVE);
+    const float halfW = perspective ? m_aspectW : m_orthoHalfW;
+    const float halfH = perspective ? m_aspectH : m_orthoHalfH;
+
+    int i = 0;
+
+    #if defined(MATRIX_SIMD_X86)
+    if( UseSSE2() )
+        i = CullCirclesSSE2( pVisibleMask, perspective, halfW, halfH, pX, pY, pDepth, pRadius, count );
+    #endif
+
+    for( ; i < count; ++i )
+    {
+        const float scale = perspective ? std::fabs(pDepth[i]) : 1.0f;
+
+        if( CircleInRect( pX[i], pY[i], halfW * scale, halfH * scale, pRadius[i] ) )
+            pVisibleMask[i >> 5] |= 1u << (i & 31);
+    }
+
+    return CountVisible( pVisibleMask, count );
+
+}   // CullCircles
+
+
+/************************************************************************
+*    desc:  Cull arrays of bounding spheres against the frustum planes
+*
+*    ret:   int - number of spheres in view
+************************************************************************/
+int CViewCull::CullSpheres(
+    uint * pVisibleMask,
+    const float * pX, const float * pY, const float * pZ,
+    const float * pRadius, int count ) const
+{
+    std::memset( pVisibleMask, 0, GetMaskSize( count ) * sizeof(uint) );
+
+    int i = 0;
+
+    #if defined(MATRIX_SIMD_X86)
+    if( UseSSE2() )
+        i = CullSpheresSSE2( pVisibleMask, m_plane, pX, pY, pZ, pRadius, count );
+    #endif
+
+    for( ; i < count; ++i )
+    {
+        if( InFrustum( CPoint<float>( pX[i], pY[i], pZ[i] ), pRadius[i] ) )
+            pVisibleMask[i >> 5] |= 1u << (i & 31);
+    }
+
+    return CountVisible( pVisibleMask, count );
+
+}   // CullSpheres
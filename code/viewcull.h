@@ -0,0 +1,89 @@
+/************************************************************************
+*    FILE NAME:       viewcull.h
+*
+*    DESCRIPTION:     View rect and frustum culling. The view values are
+*                     cached once per frame so the tests don't go back to
+*                     the settings for every object, and whole arrays of
+*                     bounding circles or spheres are culled in one pass.
+************************************************************************/
+
+#ifndef __view_cull_h__
+#define __view_cull_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <common/point.h>
+#include <common/matrix.h>
+
+class CViewCull
+{
+public:
+
+    // Get the instance of the singleton class
+    static CViewCull & Instance()
+    {
+        static CViewCull viewCull;
+        return viewCull;
+    }
+
+    // Cache the view values from the settings. Called when the
+    // projection matrixes are created.
+    void Update();
+
+    // Build the frustum planes from a view projection matrix for sphere culling
+    void SetViewProjection( const CMatrix & viewProj );
+
+    // Is the bounding circle in view. Position is relative to the camera.
+    // Depth is only used by the perspective projection.
+    bool InView( NDefs::EProjectionType type, const CPoint<float> & pos, float depth, float radius ) const;
+    bool InOrthographicView( const CPoint<float> & pos, float radius ) const;
+    bool InPerspectiveView( const CPoint<float> & pos, float depth, float radius ) const;
+
+    // Is the bounding sphere inside the frustum planes
+    bool InFrustum( const CPoint<float> & pos, float radius ) const;
+
+    // Cull arrays of bounding circles. pVisibleMask is one bit per circle
+    // and needs GetMaskSize(count) uints. pDepth is only used by the
+    // perspective projection. Returns the number in view.
+    int CullCircles(
+        uint * pVisibleMask, NDefs::EProjectionType type,
+        const float * pX, const float * pY, const float * pDepth,
+        const float * pRadius, int count ) const;
+
+    // Cull arrays of bounding spheres against the frustum planes
+    int CullSpheres(
+        uint * pVisibleMask,
+        const float * pX, const float * pY, const float * pZ,
+        const float * pRadius, int count ) const;
+
+    // Number of uints needed for the mask of this many objects
+    static int GetMaskSize( int count )
+    { return (count + 31) / 32; }
+
+    // Test a bit in the mask
+    static bool IsVisible( const uint * pVisibleMask, int index )
+    { return (pVisibleMask[index >> 5] & (1u << (index & 31))) != 0; }
+
+private:
+
+    // Constructor
+    CViewCull();
+
+    // Destructor
+    ~CViewCull();
+
+private:
+
+    // Half of the default size for the orthographic view
+    float m_orthoHalfW;
+    float m_orthoHalfH;
+
+    // Screen aspect ratio for the perspective view
+    float m_aspectW;
+    float m_aspectH;
+
+    // Frustum planes as a, b, c, d with the normals pointing in
+    float m_plane[6][4];
+};
+
+#endif  // __view_cull_h__
@@ -10,32 +10,43 @@
 #include <GL/glew.h>
 #endif
 
+#if defined(NULL_GL_BACKEND)
+// Null GL backend for headless builds (has to follow the GL headers)
+#include <system/nullgl.h>
+#endif
+
 // Physical component dependency
 #include <2d/visualcomponent2d.h>
 
 // Game lib dependencies
+#include <2d/renderqueue.h>
+#include <2d/textlayout.h>
+#include <2d/numericlayout.h>
 #include <objectdata/objectvisualdata2d.h>
 #include <managers/shadermanager.h>
 #include <managers/texturemanager.h>
 #include <managers/vertexbuffermanager.h>
 #include <managers/fontmanager.h>
+#include <managers/spritebatchmanager.h>
+#include <managers/spriteinstancemanager.h>
+#include <managers/streambuffermanager.h>
+#include <managers/textlayoutcache.h>
 #include <common/quad2d.h>
 #include <system/device.h>
 #include <utilities/xmlParser.h>
 #include <utilities/xmlparsehelper.h>
-#include <utilities/genfunc.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/statcounter.h>
 
+// Standard lib dependencies
+#include <algorithm>
+
 // AngelScript lib dependencies
 #include <angelscript.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
-// Standard lib dependencies
-#include <memory>
-
 /************************************************************************
 *    desc:  Constructer
 ************************************************************************/
@@ -43,6 +54,9 @@ CVisualComponent2d::CVisualComponent2d( const CObjectVisualData2D & visualData )
     m_programID(0),
     m_vbo( visualData.GetVBO() ),
     m_ibo( visualData.GetIBO() ),
+    m_baseVertex( visualData.GetBaseVertex() ),
+    m_iboOffset( visualData.GetIBOOffset() ),
+    m_vao(0),
     m_textureID( visualData.GetTextureID() ),
     m_vertexLocation(0),
     m_uvLocation(0),
@@ -50,6 +64,7 @@ CVisualComponent2d::CVisualComponent2d( const CObjectVisualData2D & visualData )
     m_colorLocation(0),
     m_matrixLocation(0),
     m_glyphLocation(0),
+    m_vertColorLocation(-1),
     GENERATION_TYPE( visualData.GetGenerationType() ),
     m_quadVertScale( visualData.GetVertexScale() ),
     m_visualData( visualData ),
@@ -75,6 +90,10 @@ CVisualComponent2d::CVisualComponent2d( const CObjectVisualData2D & visualData )
             m_text0Location = shaderData.GetUniformLocation( "text0" );
         }
 
+        // Batched font strings bake their color into the verts if the shader has the attribute
+        if( GENERATION_TYPE == NDefs::EGT_FONT )
+            m_vertColorLocation = glGetAttribLocation( m_programID, "in_color" );
+
         // Is this a sprite sheet? Get the glyph rect position
         if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
         {
@@ -82,20 +101,57 @@ CVisualComponent2d::CVisualComponent2d( const CObjectVisualData2D & visualData )
             
             m_glyphUV = visualData.GetSpriteSheet().GetGlyph().GetUV();
         }
+
+        // Quads and sprite sheets can be instanced if an instanced version of the shader was loaded
+        if( (GENERATION_TYPE == NDefs::EGT_QUAD) || (GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET) )
+            InitInstanceState( visualData.GetShaderID() + "_instanced" );
     }
 
 }   // constructor
 
 
+/************************************************************************
+*    desc:  Get the locations from the instanced version of the shader.
+*           The program ID is left at zero if there isn't one.
+************************************************************************/
+void CVisualComponent2d::InitInstanceState( const std::string & shaderID )
+{
+    if( !CShaderMgr::Instance().IsShader( shaderID ) )
+        return;
+
+    const CShaderData & shaderData( CShaderMgr::Instance().GetShaderData( shaderID ) );
+    const GLuint programID = shaderData.GetProgramID();
+
+    const GLint matrixLocation = glGetAttribLocation( programID, "in_instanceMatrix" );
+    if( matrixLocation < 0 )
+        return;
+
+    m_instanceState.programID = programID;
+    m_instanceState.iboCount = m_iboCount;
+    m_instanceState.drawMode = m_drawMode;
+    m_instanceState.indiceType = m_indiceType;
+    m_instanceState.vertexLocation = shaderData.GetAttributeLocation( "in_position" );
+    m_instanceState.instMatrixLocation = matrixLocation;
+    m_instanceState.instColorLocation = glGetAttribLocation( programID, "in_instanceColor" );
+
+    if( m_textureID > 0 )
+    {
+        m_instanceState.uvLocation = shaderData.GetAttributeLocation( "in_uv" );
+        m_instanceState.text0Location = shaderData.GetUniformLocation( "text0" );
+    }
+
+    if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
+        m_instanceState.instGlyphLocation = glGetAttribLocation( programID, "in_instanceGlyph" );
+
+}   // InitInstanceState
+
+
 /************************************************************************
 *    desc:  destructer
 ************************************************************************/
 CVisualComponent2d::~CVisualComponent2d()
 {
-    // Delete the VBO if this is a font
-    if( (GENERATION_TYPE == NDefs::EGT_FONT) && (m_vbo > 0) )
-        glDeleteBuffers(1, &m_vbo);
-
+    // Font quads are streamed so there's no VBO to delete.
     // The IBO for the font is managed by the vertex buffer manager.
     // Font IBO are all the same with the only difference being
     // length of the character string.
@@ -110,14 +166,186 @@ void CVisualComponent2d::Render( const CMatrix & matrix )
 {
     if( IsActive() )
     {
-        const int VERTEX_BUF_SIZE( sizeof(CVertex2D) );
-            
-        // Increment our stat counter to keep track of what is going on.
-        CStatCounter::Instance().IncDisplayCounter();
+        // If this is a quad or sprite sheet, we need to take into account the vertex scale
+        if( (GENERATION_TYPE == NDefs::EGT_QUAD) || (GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET) )
+        {
+            // Calculate the final matrix
+            CMatrix finalMatrix;
+            finalMatrix.SetScaleMerge( m_quadVertScale, matrix );
+
+            DrawElements( finalMatrix() );
+        }
+        // this is for scaled frame and font rendering
+        else
+        {
+            DrawElements( matrix() );
+        }
+    }
+
+}   // Render
+
+
+/************************************************************************
+*    desc:  Add a render command to the queue instead of rendering now.
+*           The queue sorts the commands and calls DrawElements.
+*
+*    param: CRenderQueue & queue - queue for this frame
+*           uint layer - layer, rendered lowest to highest
+*           const CMatrix & matrix - object and view projection matrix
+************************************************************************/
+void CVisualComponent2d::QueueRender( CRenderQueue & queue, uint layer, const CMatrix & matrix )
+{
+    if( IsActive() )
+    {
+        CMatrix finalMatrix( matrix );
+
+        // If this is a quad or sprite sheet, we need to take into account the vertex scale
+        if( (GENERATION_TYPE == NDefs::EGT_QUAD) || (GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET) )
+            finalMatrix.SetScaleMerge( m_quadVertScale, matrix );
+
+        // Clip space z of the origin, -1 to 1, as the 0 to 1 depth
+        const float depth = (finalMatrix()[14] + 1.f) * 0.5f;
 
-        // Bind the shader. This must be done first
-        CShaderMgr::Instance().BindShaderProgram( m_programID );
+        queue.Add( this, finalMatrix(), layer, m_programID, m_textureID, m_vbo, depth );
+    }
+
+}   // QueueRender
+
+
+/************************************************************************
+*    desc:  Issue the GL calls for the draw with the final matrix
+************************************************************************/
+void CVisualComponent2d::DrawElements( const float * pFinalMatrix )
+{
+    const int VERTEX_BUF_SIZE( sizeof(CVertex2D) );
+
+    // A font that hasn't been given a string has nothing to draw
+    if( (GENERATION_TYPE == NDefs::EGT_FONT) && !m_spFontLayout )
+        return;
+
+    // Increment our stat counter to keep track of what is going on.
+    CStatCounter::Instance().IncDisplayCounter();
+
+    CSpriteBatchMgr & rBatchMgr( CSpriteBatchMgr::Instance() );
+    CSpriteInstanceMgr & rInstanceMgr( CSpriteInstanceMgr::Instance() );
+
+    // Quads and sprite sheet frames with an instanced shader are drawn
+    // together with others that share the same mesh and texture
+    if( (m_instanceState.programID > 0) && rInstanceMgr.IsEnabled() && rInstanceMgr.IsAvailable() )
+    {
+        // Anything batched so far has to be rendered first to keep the painter's order
+        rBatchMgr.Flush();
+
+        m_instanceState.textureID = m_textureID;
+        m_instanceState.vbo = m_vbo;
+        m_instanceState.ibo = m_ibo;
+        m_instanceState.baseVertex = m_baseVertex;
+        m_instanceState.iboOffset = m_iboOffset;
+
+        if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
+            rInstanceMgr.AddInstance( m_instanceState, pFinalMatrix, m_color, &m_glyphUV );
+        else
+            rInstanceMgr.AddInstance( m_instanceState, pFinalMatrix, m_color, nullptr );
+
+        return;
+    }
+
+    // Quads and sprite sheet frames are collected by the sprite batcher
+    // and rendered together with others that share the shader and texture
+    if( ((GENERATION_TYPE == NDefs::EGT_QUAD) || (GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET)) &&
+        rBatchMgr.IsEnabled() && CSpriteBatchMgr::IsBatchable( pFinalMatrix ) )
+    {
+        rInstanceMgr.Flush();
+
+        CSpriteBatchState state;
+        state.programID = m_programID;
+        state.textureID = m_textureID;
+        state.vertexLocation = m_vertexLocation;
+        state.uvLocation = m_uvLocation;
+        state.text0Location = m_text0Location;
+        state.colorLocation = m_colorLocation;
+        state.matrixLocation = m_matrixLocation;
+        state.color = m_color;
+
+        if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
+        {
+            state.glyphLocation = m_glyphLocation;
+            rBatchMgr.AddQuad( state, pFinalMatrix, m_visualData.GetUV(), &m_glyphUV );
+        }
+        else
+        {
+            rBatchMgr.AddQuad( state, pFinalMatrix, m_visualData.GetUV(), nullptr );
+        }
+
+        return;
+    }
+
+    // Font strings are collected by the sprite batcher and rendered
+    // together with others that share the font and shader
+    if( (GENERATION_TYPE == NDefs::EGT_FONT) &&
+        rBatchMgr.IsEnabled() && CSpriteBatchMgr::IsBatchable( pFinalMatrix ) )
+    {
+        rInstanceMgr.Flush();
+
+        CSpriteBatchState state;
+        state.programID = m_programID;
+        state.textureID = m_textureID;
+        state.vertexLocation = m_vertexLocation;
+        state.uvLocation = m_uvLocation;
+        state.text0Location = m_text0Location;
+        state.colorLocation = m_colorLocation;
+        state.matrixLocation = m_matrixLocation;
+        state.vertColorLocation = m_vertColorLocation;
+        state.color = m_color;
+
+        const std::vector<CQuad2D> & quadVec( m_spFontLayout->quadVec );
+        rBatchMgr.AddQuads( state, pFinalMatrix, quadVec.data(), quadVec.size() );
+
+        return;
+    }
+
+    // Anything batched so far has to be rendered first to keep the painter's order
+    rInstanceMgr.Flush();
+    rBatchMgr.Flush();
+
+    // Bind the shader. This must be done first
+    CShaderMgr::Instance().BindShaderProgram( m_programID );
+
+    // Send the color to the shader
+    CShaderMgr::Instance().SetUniform4fv( m_colorLocation, (float *)&m_color );
 
+    // Send the final matrix to the shader
+    CShaderMgr::Instance().SetUniformMatrix4fv( m_matrixLocation, pFinalMatrix );
+
+    // Font quads are streamed into the ring buffer every render and
+    // drawn in chunks the font IBO can index
+    if( GENERATION_TYPE == NDefs::EGT_FONT )
+    {
+        DrawFontString();
+        return;
+    }
+
+    // If this is a sprite sheet, send the glyph rect
+    if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
+        CShaderMgr::Instance().SetUniform4fv( m_glyphLocation, (GLfloat *)&m_glyphUV );
+
+    // The VAO holds the buffers and the attribute setup so it's made once
+    if( (m_vao == 0) && (m_vbo > 0) )
+        m_vao = CVertBufMgr::Instance().GetVAO( m_vbo, m_ibo, m_programID, m_vertexLocation, (m_textureID > 0) ? m_uvLocation : -1 );
+
+    if( m_vao > 0 )
+    {
+        CVertBufMgr::Instance().BindVAO( m_vao, m_ibo );
+
+        // Bind the texture
+        if( m_textureID > 0 )
+        {
+            CTextureMgr::Instance().BindTexture2D( m_textureID );
+            CShaderMgr::Instance().SetUniform1i( m_text0Location, 0 ); // 0 = TEXTURE0
+        }
+    }
+    else
+    {
         // Bind the VBO and IBO
         CVertBufMgr::Instance().BindBuffers( m_vbo, m_ibo );
 
@@ -125,10 +353,10 @@ void CVisualComponent2d::Render( const CMatrix & matrix )
         if( m_textureID > 0 )
         {
             const int UV_OFFSET( sizeof(CPoint<float>) );
-            
+
             // Bind the texture
             CTextureMgr::Instance().BindTexture2D( m_textureID );
-            glUniform1i( m_text0Location, 0); // 0 = TEXTURE0
+            CShaderMgr::Instance().SetUniform1i( m_text0Location, 0 ); // 0 = TEXTURE0
 
             // Enable the UV attribute shade data
             glEnableVertexAttribArray( m_uvLocation );
@@ -138,46 +366,57 @@ void CVisualComponent2d::Render( const CMatrix & matrix )
         // Enable the vertex attribute shader data
         glEnableVertexAttribArray( m_vertexLocation );
         glVertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, nullptr );
+    }
 
-        // Send the color to the shader
-        glUniform4fv( m_colorLocation, 1, (float *)&m_color );
+    // Render it. The mesh can be anywhere in it's group's arena.
+    CVertBufMgr::Instance().DrawElements( m_drawMode, m_iboCount, m_indiceType, m_iboOffset, m_baseVertex );
 
-        // If this is a quad, we need to take into account the vertex scale
-        if( GENERATION_TYPE == NDefs::EGT_QUAD )
-        {
-            // Calculate the final matrix
-            CMatrix finalMatrix;
-            finalMatrix.Scale( m_quadVertScale );
-            finalMatrix *= matrix;
+}   // DrawElements
 
-            // Send the final matrix to the shader
-            glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, finalMatrix() );
-        }
-        // If this is a sprite sheet, we need to take into account the vertex scale and glyph rect
-        else if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
-        {
-            // Calculate the final matrix
-            CMatrix finalMatrix;
-            finalMatrix.Scale( m_quadVertScale );
-            finalMatrix *= matrix;
 
-            // Send the final matrix to the shader
-            glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, finalMatrix() );
-            
-            // Send the glyph rect
-            glUniform4fv( m_glyphLocation, 1, (GLfloat *)&m_glyphUV );
-        }
-        // this is for scaled frame and font rendering
-        else
-        {
-            glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, matrix() );
-        }
+/************************************************************************
+*    desc:  Stream the font quads and draw them. A string longer than the
+*           font IBO can index is drawn in chunks. The shader, color and
+*           matrix have already been set.
+************************************************************************/
+void CVisualComponent2d::DrawFontString()
+{
+    const int VERTEX_BUF_SIZE( sizeof(CVertex2D) );
+    const int UV_OFFSET( sizeof(CPoint<float>) );
+
+    CStreamBufMgr & rStreamBufMgr( CStreamBufMgr::Instance() );
+    const std::vector<CQuad2D> & quadVec( m_spFontLayout->quadVec );
+
+    CTextureMgr::Instance().BindTexture2D( m_textureID );
+    CShaderMgr::Instance().SetUniform1i( m_text0Location, 0 ); // 0 = TEXTURE0
 
-        // Render it
-        glDrawElements( m_drawMode, m_iboCount, m_indiceType, nullptr );
+    // The color is only baked into the verts when batched. Otherwise the shader
+    // gets white from the disabled attribute so the color uniform applies.
+    if( m_vertColorLocation > -1 )
+    {
+        glDisableVertexAttribArray( m_vertColorLocation );
+        glVertexAttrib4f( m_vertColorLocation, 1.f, 1.f, 1.f, 1.f );
     }
 
-}   // Render
+    for( size_t first = 0; first < quadVec.size(); first += CVertBufMgr::MAX_FONT_QUADS )
+    {
+        const size_t quadCount = std::min( quadVec.size() - first, (size_t)CVertBufMgr::MAX_FONT_QUADS );
+
+        // The attributes point at where the chunk landed in the ring buffer
+        const size_t vertOffset = rStreamBufMgr.Stream( &quadVec[first], sizeof(CQuad2D) * quadCount );
+
+        CVertBufMgr::Instance().BindBuffers( rStreamBufMgr.GetBufferID(), m_ibo );
+
+        glEnableVertexAttribArray( m_uvLocation );
+        glVertexAttribPointer( m_uvLocation, 2, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)(vertOffset + UV_OFFSET) );
+
+        glEnableVertexAttribArray( m_vertexLocation );
+        glVertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (void*)vertOffset );
+
+        CVertBufMgr::Instance().DrawElements( m_drawMode, quadCount * 6, m_indiceType, 0, 0 );
+    }
+
+}   // DrawFontString
 
 
 /************************************************************************
@@ -239,346 +478,76 @@ void CVisualComponent2d::CreateFontString(
     // Qualify if we want to build the font string
     if( !fontString.empty() && !fontProp.m_fontName.empty() && (fontString != m_fontString) )
     {
-        m_fontStrSize.Reset();
-        float lastCharDif(0.f);
-        
         const CFont & font = CFontMgr::Instance().GetFont( fontProp.m_fontName );
 
         m_textureID = font.GetTextureID();
 
         m_fontString = fontString;
 
-        // count up the number of space characters
-        const int spaceCharCount = NGenFunc::CountStrOccurrence( m_fontString, " " );
-
-        // count up the number of bar | characters
-        const int barCharCount = NGenFunc::CountStrOccurrence( m_fontString, "|" );
-
-        // Size of the allocation
-        int charCount = m_fontString.size() - spaceCharCount - barCharCount;
-		m_iboCount = charCount * 6;
-
-        // Allocate the quad array
-        std::unique_ptr<CQuad2D[]> upQuadBuf( new CQuad2D[charCount] );
-
-        // Create a buffer to hold the indicies
-        std::unique_ptr<GLushort[]> upIndxBuf( new GLushort[m_iboCount] );
-
-        float xOffset = 0.f;
-        float width = 0.f;
-        float lineHeightOffset = 0.f;
-        float lineHeightWrap = font.GetLineHeight() + font.GetVertPadding() + fontProp.m_lineWrapHeight;
-        float initialHeightOffset = font.GetBaselineOffset() + font.GetVertPadding();
-        float lineSpace = font.GetLineHeight() - font.GetBaselineOffset();
-
-        uint counter = 0;
-        int lineCount = 0;
-
-        // Get the size of the texture
-        CSize<float> textureSize = font.GetTextureSize();
-
-        // Handle the horizontal alignment
-        std::vector<float> lineWidthOffsetVec = CalcLineWidthOffset( font, m_fontString, fontProp );
-
-        // Set the initial line offset
-        xOffset = lineWidthOffsetVec[lineCount++];
-
-        // Handle the vertical alighnmenrt
-        if( fontProp.m_vAlign == NDefs::EVA_VERT_TOP )
-            lineHeightOffset = -initialHeightOffset;
-
-        if( fontProp.m_vAlign == NDefs::EVA_VERT_CENTER )
-        {
-            lineHeightOffset = -(initialHeightOffset - ((font.GetBaselineOffset()-lineSpace) / 2.f) - font.GetVertPadding());
-
-            if( lineWidthOffsetVec.size() > 1 )
-                lineHeightOffset = ((lineHeightWrap * lineWidthOffsetVec.size()) / 2.f) - font.GetBaselineOffset();
-        }
-
-        else if( fontProp.m_vAlign == NDefs::EVA_VERT_BOTTOM )
-        {
-            lineHeightOffset = -(initialHeightOffset - font.GetBaselineOffset() - font.GetVertPadding());
-
-            if( lineWidthOffsetVec.size() > 1 )
-                lineHeightOffset += (lineHeightWrap * (lineWidthOffsetVec.size()-1));
-        }
-
-        // Remove any fractional component of the line height offset
-        lineHeightOffset = (int)lineHeightOffset;
-
-        // Setup each character in the vertex buffer
-        for( size_t i = 0; i < m_fontString.size(); ++i )
-        {
-            char id = m_fontString[i];
-
-            // Line wrap if '|' character was used
-            if( id == '|' )
-            {
-                xOffset = lineWidthOffsetVec[lineCount];
-                width = 0.f;
-
-                lineHeightOffset += -lineHeightWrap;
-                ++lineCount;
-            }
-            else
-            {
-                // See if we can find the character
-                const CCharData & charData = font.GetCharData(id);
-
-                // Ignore space characters
-                if( id != ' ' )
-                {
-                    CRect<float> rect = charData.rect;
-
-                    float yOffset = (font.GetLineHeight() - rect.y2 - charData.offset.h) + lineHeightOffset;
-
-                    // Check if the width or height is odd. If so, we offset
-                    // by 0.5 for proper orthographic rendering
-                    float additionalOffsetX = 0;
-                    if( (int)rect.x2 % 2 != 0 )
-                        additionalOffsetX = 0.5f;
-
-                    float additionalOffsetY = 0;
-                    if( (int)rect.y2 % 2 != 0 )
-                        additionalOffsetY = 0.5f;
-
-                    // Calculate the first vertex of the first face
-                    upQuadBuf[counter].vert[0].vert.x = xOffset + charData.offset.w + additionalOffsetX;
-                    upQuadBuf[counter].vert[0].vert.y = yOffset + additionalOffsetY;
-                    upQuadBuf[counter].vert[0].uv.u = rect.x1 / textureSize.w;
-                    upQuadBuf[counter].vert[0].uv.v = (rect.y1 + rect.y2) / textureSize.h;
-
-                    // Calculate the second vertex of the first face
-                    upQuadBuf[counter].vert[1].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
-                    upQuadBuf[counter].vert[1].vert.y = yOffset + rect.y2 + additionalOffsetY;
-                    upQuadBuf[counter].vert[1].uv.u = (rect.x1 + rect.x2) / textureSize.w;
-                    upQuadBuf[counter].vert[1].uv.v = rect.y1 / textureSize.h;
-
-                    // Calculate the third vertex of the first face
-                    upQuadBuf[counter].vert[2].vert.x = xOffset + charData.offset.w + additionalOffsetX;
-                    upQuadBuf[counter].vert[2].vert.y = yOffset + rect.y2 + additionalOffsetY;
-                    upQuadBuf[counter].vert[2].uv.u = rect.x1 / textureSize.w;
-                    upQuadBuf[counter].vert[2].uv.v = rect.y1 / textureSize.h;
-
-                    // Calculate the second vertex of the second face
-                    upQuadBuf[counter].vert[3].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
-                    upQuadBuf[counter].vert[3].vert.y = yOffset + additionalOffsetY;
-                    upQuadBuf[counter].vert[3].uv.u = (rect.x1 + rect.x2) / textureSize.w;
-                    upQuadBuf[counter].vert[3].uv.v = (rect.y1 + rect.y2) / textureSize.h;
-
-                    // Create the indicies into the VBO
-                    int arrayIndex = counter * 6;
-                    int vertIndex = counter * 4;
-
-                    upIndxBuf[arrayIndex] = vertIndex;
-                    upIndxBuf[arrayIndex+1] = vertIndex+1;
-                    upIndxBuf[arrayIndex+2] = vertIndex+2;
-
-                    upIndxBuf[arrayIndex+3] = vertIndex;
-                    upIndxBuf[arrayIndex+4] = vertIndex+3;
-                    upIndxBuf[arrayIndex+5] = vertIndex+1;
-
-                    ++counter;
-                }
-
-                // Inc the font position
-                float inc = charData.xAdvance + fontProp.m_kerning + font.GetHorzPadding();
-
-                // Add in any additional spacing for the space character
-                if( id == ' ' )
-                    inc += fontProp.m_spaceCharKerning;
-
-                width += inc;
-                xOffset += inc;
-                
-                // Get the longest width of this font string
-                if( m_fontStrSize.w < width )
-                {
-                    m_fontStrSize.w = width;
-                    
-                    // This is the space between this character and the next.
-                    // Save this difference so that it can be subtracted at the end
-                    lastCharDif = inc - charData.rect.x2;
-                }
-
-                // Wrap to another line
-                if( (id == ' ') && (fontProp.m_lineWrapWidth > 0.f) )
-                {
-                    float nextWord = 0.f;
-
-                    // Get the length of the next word to see if if should wrap
-                    for( size_t j = i+1; j < m_fontString.size(); ++j )
-                    {
-                        id = m_fontString[j];
-
-                        if( id != '|' )
-                        {
-                            // See if we can find the character
-                            const CCharData & anotherCharData = font.GetCharData(id);
-
-                            // Break here when space is found
-                            // Don't add the space to the size of the next word
-                            if( id == ' ' )
-                                break;
-
-                            // Don't count the
-                            nextWord += anotherCharData.xAdvance + fontProp.m_kerning + font.GetHorzPadding();
-                        }
-                    }
-
-                    if( width + nextWord >= fontProp.m_lineWrapWidth )
-                    {
-                        xOffset = lineWidthOffsetVec[lineCount++];
-                        width = 0.f;
-
-                        lineHeightOffset += -lineHeightWrap;
-                    }
-                }
-            }
-        }
-        
-        // Subtract the extra space after the last character
-        m_fontStrSize.w -= lastCharDif;
-        m_fontStrSize.h = font.GetLineHeight();
-
-        // Save the data
-        // If one doesn't exist, create the VBO and IBO for this font
-        if( m_vbo == 0 )
-            glGenBuffers( 1, &m_vbo );
-
-        glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CQuad2D) * charCount, upQuadBuf.get(), GL_STATIC_DRAW );
+        // Components showing the same string share the layout. The quads
+        // are kept and streamed each time the string is rendered.
+        m_spFontLayout = CTextLayoutCache::Instance().GetLayout( font, m_fontString, fontProp );
+        m_fontStrSize = m_spFontLayout->size;
+        // The IBO holds at most MAX_FONT_QUADS. Longer strings are drawn in chunks.
+        m_iboCount = std::min( m_spFontLayout->quadVec.size(), (size_t)CVertBufMgr::MAX_FONT_QUADS ) * 6;
 
         // All fonts share the same IBO because it's always the same and the only difference is it's length
-        // This updates the current IBO if it exceeds the current max
-        m_ibo = CVertBufMgr::Instance().CreateDynamicFontIBO( CFontMgr::Instance().GetGroup(), "dynamic_font_ibo", upIndxBuf.get(), m_iboCount );
-
-        // unbind the buffers
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        // This grows the IBO if the string is longer then any before it
+        m_ibo = CVertBufMgr::Instance().CreateDynamicFontIBO( CFontMgr::Instance().GetGroup(), "dynamic_font_ibo", m_iboCount );
     }
 
 }   // SetFontString
 
 
 /************************************************************************
-*    desc:  Add up all the character widths
+*    desc:  Create a font string that changes often, like a meter.
+*           Only the glyphs that changed are rebuilt and the layout
+*           isn't shared or cached.
+*
+*    NOTE: Line breaks and line wrap aren't supported
 ************************************************************************/
-std::vector<float> CVisualComponent2d::CalcLineWidthOffset(
-    const CFont & font,
-    const std::string & str,
-    const CFontProperties & fontProp )
+void CVisualComponent2d::CreateNumericString( const std::string & fontString )
 {
-    float firstCharOffset = 0;
-    float lastCharOffset = 0;
-    float spaceWidth = 0;
-    float width = 0;
-    int counter = 0;
-    std::vector<float> lineWidthOffsetVec;
-
-    for( size_t i = 0; i < str.size(); ++i )
+    // Qualify if we want to build the font string
+    if( !fontString.empty() && !m_fontProp.m_fontName.empty() && (fontString != m_fontString) )
     {
-        char id = str[i];
-
-        // Line wrap if '|' character was used
-        if( id == '|' )
-        {
-            // Add the line width to the vector based on horz alignment
-            AddLineWithToVec( font, lineWidthOffsetVec, fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
+        const CFont & font = CFontMgr::Instance().GetFont( m_fontProp.m_fontName );
 
-            counter = 0;
-            width = 0;
-        }
-        else
-        {
-            // Get the next character
-            const CCharData & charData = font.GetCharData( id );
-
-            if(counter == 0)
-                    firstCharOffset = charData.offset.w;
-
-            spaceWidth = charData.xAdvance + fontProp.m_kerning + font.GetHorzPadding();
+        m_textureID = font.GetTextureID();
 
-            // Add in any additional spacing for the space character
-            if( id == ' ' )
-                    spaceWidth += fontProp.m_spaceCharKerning;
+        m_fontString = fontString;
 
-            width += spaceWidth;
+        if( !m_upNumericLayout )
+            m_upNumericLayout.reset( new CNumericLayout );
 
-            if( id != ' ')
-                    lastCharOffset = charData.offset.w;
+        m_upNumericLayout->Update( font, m_fontString, m_fontProp );
 
-            ++counter;
-        }
+        m_spFontLayout = m_upNumericLayout->GetData();
+        m_fontStrSize = m_spFontLayout->size;
+        // The IBO holds at most MAX_FONT_QUADS. Longer strings are drawn in chunks.
+        m_iboCount = std::min( m_spFontLayout->quadVec.size(), (size_t)CVertBufMgr::MAX_FONT_QUADS ) * 6;
 
-        // Wrap to another line
-        if( (id == ' ') && (fontProp.m_lineWrapWidth > 0.f) )
-        {
-            float nextWord = 0.f;
-
-            // Get the length of the next word to see if if should wrap
-            for( size_t j = i+1; j < str.size(); ++j )
-            {
-                id = str[j];
-
-                if( id != '|' )
-                {
-                    // See if we can find the character
-                    const CCharData & charData = font.GetCharData(id);
-
-                    // Break here when space is found
-                    // Don't add the space to the size of the next word
-                    if( id == ' ' )
-                        break;
-
-                    // Don't count the
-                    nextWord += charData.xAdvance + fontProp.m_kerning + font.GetHorzPadding();
-                }
-            }
-
-            if( width + nextWord >= fontProp.m_lineWrapWidth )
-            {
-                // Add the line width to the vector based on horz alignment
-                AddLineWithToVec( font, lineWidthOffsetVec, fontProp.m_hAlign, width-spaceWidth, firstCharOffset, lastCharOffset );
-
-                counter = 0;
-                width = 0;
-            }
-        }
+        // Only grows the IBO if the string is longer then any before it
+        m_ibo = CVertBufMgr::Instance().CreateDynamicFontIBO( CFontMgr::Instance().GetGroup(), "dynamic_font_ibo", m_iboCount );
     }
 
-    // Add the line width to the vector based on horz alignment
-    AddLineWithToVec( font, lineWidthOffsetVec, fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
-
-    return lineWidthOffsetVec;
-
-}   // CalcLineWidthOffset
+}   // CreateNumericString
 
 
 /************************************************************************
-*    desc:  Add the line width to the vector based on horz alignment
+*    desc:  Get the horizontal alignment offset of each line
 ************************************************************************/
-void CVisualComponent2d::AddLineWithToVec(
+std::vector<float> CVisualComponent2d::CalcLineWidthOffset(
     const CFont & font,
-    std::vector<float> & lineWidthOffsetVec,
-    const NDefs::EHorzAlignment hAlign,
-    float width,
-    float firstCharOffset,
-    float lastCharOffset )
+    const std::string & str,
+    const CFontProperties & fontProp )
 {
-    if( hAlign == NDefs::EHA_HORZ_LEFT )
-        lineWidthOffsetVec.push_back(-(firstCharOffset + font.GetHorzPadding()));
-
-    else if( hAlign == NDefs::EHA_HORZ_CENTER )
-        lineWidthOffsetVec.push_back(-((width + (firstCharOffset + lastCharOffset)) / 2.f));
+    CTextLayout textLayout;
+    textLayout.Layout( font, str, fontProp, false );
 
-    else if( hAlign == NDefs::EHA_HORZ_RIGHT )
-        lineWidthOffsetVec.push_back(-(width - lastCharOffset - font.GetHorzPadding()));
+    return textLayout.GetLineOffsetVec();
 
-    // Remove any fractional component of the line height offset
-    lineWidthOffsetVec.back() = (int)lineWidthOffsetVec.back();
-
-}   // AddLineWithToVec
+}   // CalcLineWidthOffset
 
 
 /************************************************************************